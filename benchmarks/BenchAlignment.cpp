@@ -0,0 +1,48 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Main.hpp"
+#include <Core/Simd.hpp>
+#include <string>
+
+/// Number of floats in each array                                            
+constexpr Count AlignmentCount = 4096;
+/// Arrays are aligned for the widest registers, and have room to be offset   
+alignas(64) static float AlignmentArrays[3][AlignmentCount + 16];
+
+
+void BenchmarkAlignment(Benchmark& bench) {
+   // Full-width vectors of the registers, that the code is built for   
+   using V = Simd<float, (SimdWidth ? SimdWidth : 16) / sizeof(float)>;
+
+   for (Offset i = 0; i < AlignmentCount + 16; ++i) {
+      AlignmentArrays[0][i] = static_cast<float>(i);
+      AlignmentArrays[1][i] = static_cast<float>(i) * 0.5f;
+   }
+
+   // Sum two arrays into a third, with all three of them misaligned    
+   // by the same number of bytes                                       
+   for (Offset bytes : {0, 4, 16, 32}) {
+      if (bytes and bytes >= V::Bytes)
+         continue;
+
+      const auto shift = bytes / sizeof(float);
+      const auto a = AlignmentArrays[0] + shift;
+      const auto b = AlignmentArrays[1] + shift;
+      const auto c = AlignmentArrays[2] + shift;
+      const auto name = "Add<float[4096]> + " + ::std::to_string(bytes)
+         + " bytes, " + ::std::to_string(V::Bytes) + "-byte vectors";
+
+      bench.Run(name, [&] {
+         for (Offset i = 0; i < AlignmentCount; i += V::Lanes)
+            (V::Load(a + i) + V::Load(b + i)).Store(c + i);
+         ClobberMemory();
+      });
+      Check(c[AlignmentCount - 1] == a[AlignmentCount - 1] + b[AlignmentCount - 1],
+         "Misaligned vector add computes the sum");
+   }
+}
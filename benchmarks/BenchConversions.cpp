@@ -0,0 +1,125 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Main.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/// Number of values to cycle through, so that branches aren't predicted      
+/// from a single value                                                       
+constexpr Count ConversionCount = 1024;
+
+/// Deterministic pseudo-random numbers                                       
+static ::std::uint64_t ConversionRandom(::std::uint64_t& state) noexcept {
+   state ^= state << 13;
+   state ^= state >> 7;
+   state ^= state << 17;
+   return state;
+}
+
+/// Benchmark ToChars/FromChars against ::std::to_chars/from_chars, and       
+/// check that they produce the same texts, and parse the same values         
+///   @param bench - the harness                                              
+///   @param type - name of the type, as reported                             
+///   @param values - the values to cycle through                             
+template<class T>
+static void BenchmarkConversionType(
+   Benchmark& bench, const ::std::string& type, const ::std::vector<T>& values
+) {
+   // Texts, as ::std::to_chars writes them                             
+   ::std::vector<::std::string> texts(ConversionCount);
+   bool same = true;
+   for (Offset i = 0; i < ConversionCount; ++i) {
+      Letter expected[MaxCharsOf<T>];
+      Letter buffer[MaxCharsOf<T>];
+      const auto end = ::std::to_chars(expected, expected + MaxCharsOf<T>, values[i]).ptr;
+      texts[i].assign(expected, end);
+      same &= ToChars(buffer, values[i]) - buffer == end - expected
+          and ::std::memcmp(buffer, expected, end - expected) == 0;
+
+      T parsed {};
+      FromChars(texts[i].data(), texts[i].data() + texts[i].size(), parsed);
+      same &= ::std::memcmp(&parsed, &values[i], sizeof(T)) == 0;
+   }
+   Check(same, "ToChars/FromChars are the same as std::to_chars/from_chars");
+
+   Offset i = 0;
+   Letter buffer[MaxCharsOf<T>];
+   bench.Run("ToChars<" + type + ">", [&] {
+      const auto& value = values[i++ % ConversionCount];
+      DoNotOptimize(value);
+      ToChars(buffer, value);
+      DoNotOptimize(buffer);
+   });
+   bench.Run("std::to_chars<" + type + ">", [&] {
+      const auto& value = values[i++ % ConversionCount];
+      DoNotOptimize(value);
+      ::std::to_chars(buffer, buffer + MaxCharsOf<T>, value);
+      DoNotOptimize(buffer);
+   });
+
+   T parsed {};
+   bench.Run("FromChars<" + type + ">", [&] {
+      const auto& text = texts[i++ % ConversionCount];
+      DoNotOptimize(text);
+      FromChars(text.data(), text.data() + text.size(), parsed);
+      DoNotOptimize(parsed);
+   });
+   bench.Run("std::from_chars<" + type + ">", [&] {
+      const auto& text = texts[i++ % ConversionCount];
+      DoNotOptimize(text);
+      ::std::from_chars(text.data(), text.data() + text.size(), parsed);
+      DoNotOptimize(parsed);
+   });
+}
+
+/// Integers of any number of digits                                          
+template<CT::BuiltinInteger T>
+static void BenchmarkIntegerType(Benchmark& bench, const ::std::string& type) {
+   ::std::uint64_t state = 0x9E3779B97F4A7C15ull;
+   ::std::vector<T> values(ConversionCount);
+   for (auto& value : values) {
+      const auto r = ConversionRandom(state);
+      value = static_cast<T>(r >> (r % (sizeof(T) * 8)));
+   }
+   BenchmarkConversionType(bench, type, values);
+}
+
+void BenchmarkIntegerConversions(Benchmark& bench) {
+   BenchmarkIntegerType<::std::uint32_t>(bench, "uint32");
+   BenchmarkIntegerType<::std::int32_t>(bench, "int32");
+   BenchmarkIntegerType<::std::uint64_t>(bench, "uint64");
+   BenchmarkIntegerType<::std::int64_t>(bench, "int64");
+}
+
+/// Reals of any magnitude, via random finite bit patterns, and reals with    
+/// few decimals, as they usually appear in scene and telemetry dumps         
+template<CT::ConvertibleReal T>
+static void BenchmarkRealType(Benchmark& bench, const ::std::string& type) {
+   using Bits = ::std::conditional_t<sizeof(T) == 4, ::std::uint32_t, ::std::uint64_t>;
+   ::std::uint64_t state = 0x9E3779B97F4A7C15ull;
+   ::std::vector<T> values(ConversionCount);
+   for (auto& value : values) {
+      do value = ::std::bit_cast<T>(static_cast<Bits>(ConversionRandom(state)));
+      while (not ::std::isfinite(value));
+   }
+   BenchmarkConversionType(bench, type + ", any bits", values);
+
+   for (auto& value : values) {
+      const auto r = ConversionRandom(state);
+      value = static_cast<T>(static_cast<::std::int64_t>(r % 2000000) - 1000000) / T(1000);
+   }
+   BenchmarkConversionType(bench, type + ", 3 decimals", values);
+}
+
+void BenchmarkRealConversions(Benchmark& bench) {
+   BenchmarkRealType<Float>(bench, "Float");
+   BenchmarkRealType<Double>(bench, "Double");
+}
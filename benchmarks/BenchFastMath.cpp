@@ -0,0 +1,149 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Main.hpp"
+#include <Core/FastMath.hpp>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// Number of samples, that accuracy is measured on                           
+constexpr Count FastMathSamples = 1 << 16;
+/// Number of elements in the benchmarked spans                               
+constexpr Count FastMathSpan = 4096;
+
+/// Precision tiers, as template arguments of generic lambdas                 
+template<Precision P>
+using PrecisionTag = ::std::integral_constant<Precision, P>;
+
+/// Deterministic pseudo-random reals, uniformly in [min, max), or            
+/// uniformly in the exponent, if logarithmic                                 
+template<class T>
+static ::std::vector<T> FastMathInputs(
+   const T min, const T max, const bool logarithmic, ::std::uint64_t seed
+) {
+   ::std::vector<T> inputs(FastMathSamples);
+   for (auto& input : inputs) {
+      seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+      const auto t = static_cast<long double>(seed >> 11) * 0x1p-53L;
+      input = static_cast<T>(logarithmic
+         ? ::std::exp(::std::log(min) + t * (::std::log(max) - ::std::log(min)))
+         : min + t * (max - min));
+   }
+   return inputs;
+}
+
+/// Error of a result, in units in the last place of T, as the full tier      
+/// is specified                                                              
+template<class T>
+static long double FastMathUlps(const T result, const long double reference) {
+   const auto rounded = static_cast<T>(reference);
+   const auto exponent = rounded == 0 ? ::std::numeric_limits<T>::min_exponent - 1
+      : ::std::max(::std::ilogb(rounded), ::std::numeric_limits<T>::min_exponent - 1);
+   const auto ulp = ::std::ldexp(1.0L, exponent - (::std::numeric_limits<T>::digits - 1));
+   return ::std::fabs(result - reference) / ulp;
+}
+
+/// Measure the accuracy of a fast math function at all precision tiers,      
+/// check that it is within the specification, and benchmark all tiers        
+/// against the standard library                                              
+///   @param bench - the harness                                              
+///   @param name - name of the function and type, as reported                
+///   @param absolute - true if errors are absolute, instead of relative      
+///   @param fast - fast(tag, output, count) computes the first count results 
+///                 at the tier of tag                                        
+///   @param standard - standard(output, count) computes the same, but via    
+///                     libm                                                  
+///   @param reference - reference(i) is the exact i-th result                
+template<class T, class FAST, class STD, class REF>
+static void FastMathCase(
+   Benchmark& bench, const ::std::string& name, const bool absolute,
+   FAST&& fast, STD&& standard, REF&& reference
+) {
+   ::std::vector<T> output(FastMathSamples);
+   auto measure = [&]<Precision P>(PrecisionTag<P> tag, const char* tier, const long double limit) {
+      fast(tag, output.data(), FastMathSamples);
+      long double worst = 0;
+      for (Offset i = 0; i < FastMathSamples; ++i) {
+         const auto exact = reference(i);
+         const auto error = P == Precision::Full
+            ? FastMathUlps(output[i], exact)
+            : ::std::fabs(output[i] - exact) / (absolute ? 1 : ::std::fabs(exact));
+         if (not (error <= worst))
+            worst = error;
+      }
+
+      // The accuracy report goes apart from the JSON results           
+      ::std::fprintf(stderr, "%s, %s: max %s %Lg\n", name.c_str(), tier,
+         P == Precision::Full ? "ULP" : absolute ? "absolute error" : "relative error",
+         worst);
+      Check(worst <= limit, (name + ", " + tier + ": error is within the specification").c_str());
+
+      bench.Run(name + ", " + tier, [&] {
+         fast(tag, output.data(), FastMathSpan);
+         ClobberMemory();
+      });
+   };
+
+   measure(PrecisionTag<Precision::Full> {}, "Full", 4);
+   measure(PrecisionTag<Precision::Medium> {}, "Medium", 2e-4L);
+   measure(PrecisionTag<Precision::Low> {}, "Low", 2e-2L);
+
+   bench.Run(name + ", libm", [&] {
+      standard(output.data(), FastMathSpan);
+      ClobberMemory();
+   });
+}
+
+/// Measure all fast math functions for a type                                
+template<class T>
+static void FastMathType(Benchmark& bench, const ::std::string& type) {
+   constexpr bool F32 = CT::Exact<T, float>;
+   const auto exps = FastMathInputs<T>(F32 ? -87 : -700, F32 ? 87 : 700, false, 1);
+   const auto angles = FastMathInputs<T>(-100, 100, false, 2);
+   const auto positives = FastMathInputs<T>(F32 ? 1e-30f : 1e-300, F32 ? 1e30f : 1e300, true, 3);
+   const auto bases = FastMathInputs<T>(T(0.01), 100, true, 4);
+   const auto exponents = FastMathInputs<T>(-10, 10, false, 5);
+
+   FastMathCase<T>(bench, "FastExp<" + type + ">", false,
+      [&](auto tag, T* out, Count n) { FastExp<decltype(tag)::value>(exps.data(), out, n); },
+      [&](T* out, Count n) { for (Offset i = 0; i < n; ++i) out[i] = ::std::exp(exps[i]); },
+      [&](Offset i) { return ::std::exp(static_cast<long double>(exps[i])); }
+   );
+   FastMathCase<T>(bench, "FastLog<" + type + ">", false,
+      [&](auto tag, T* out, Count n) { FastLog<decltype(tag)::value>(positives.data(), out, n); },
+      [&](T* out, Count n) { for (Offset i = 0; i < n; ++i) out[i] = ::std::log(positives[i]); },
+      [&](Offset i) { return ::std::log(static_cast<long double>(positives[i])); }
+   );
+   FastMathCase<T>(bench, "FastSin<" + type + ">", true,
+      [&](auto tag, T* out, Count n) { FastSin<decltype(tag)::value>(angles.data(), out, n); },
+      [&](T* out, Count n) { for (Offset i = 0; i < n; ++i) out[i] = ::std::sin(angles[i]); },
+      [&](Offset i) { return ::std::sin(static_cast<long double>(angles[i])); }
+   );
+   FastMathCase<T>(bench, "FastCos<" + type + ">", true,
+      [&](auto tag, T* out, Count n) { FastCos<decltype(tag)::value>(angles.data(), out, n); },
+      [&](T* out, Count n) { for (Offset i = 0; i < n; ++i) out[i] = ::std::cos(angles[i]); },
+      [&](Offset i) { return ::std::cos(static_cast<long double>(angles[i])); }
+   );
+   FastMathCase<T>(bench, "FastRSqrt<" + type + ">", false,
+      [&](auto tag, T* out, Count n) { FastRSqrt<decltype(tag)::value>(positives.data(), out, n); },
+      [&](T* out, Count n) { for (Offset i = 0; i < n; ++i) out[i] = 1 / ::std::sqrt(positives[i]); },
+      [&](Offset i) { return 1 / ::std::sqrt(static_cast<long double>(positives[i])); }
+   );
+   FastMathCase<T>(bench, "FastPow<" + type + ">", false,
+      [&](auto tag, T* out, Count n) { FastPow<decltype(tag)::value>(bases.data(), exponents.data(), out, n); },
+      [&](T* out, Count n) { for (Offset i = 0; i < n; ++i) out[i] = ::std::pow(bases[i], exponents[i]); },
+      [&](Offset i) { return ::std::pow(static_cast<long double>(bases[i]), static_cast<long double>(exponents[i])); }
+   );
+}
+
+void BenchmarkFastMath(Benchmark& bench) {
+   FastMathType<float>(bench, "float");
+   FastMathType<double>(bench, "double");
+}
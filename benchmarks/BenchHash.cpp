@@ -0,0 +1,62 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Main.hpp"
+#include <Core/Hash.hpp>
+#include <functional>
+#include <string>
+#include <string_view>
+
+
+void BenchmarkHash(Benchmark& bench) {
+   constexpr auto compileTime = HashOf(::std::string_view {"Langulus"});
+   ::std::string runtime = "Langulus";
+   DoNotOptimize(runtime);
+   Check(compileTime == HashOf(::std::string_view {runtime}),
+      "HashOf is the same at compile-time and at runtime");
+
+   {
+      ::std::uint64_t x = 0;
+      bench.Run("HashOf<uint64>", [&] {
+         DoNotOptimize(x);
+         return HashOf(x++);
+      });
+      bench.Run("std::hash<uint64>", [&] {
+         DoNotOptimize(x);
+         return ::std::hash<::std::uint64_t> {}(x++);
+      });
+   }
+
+   // Small inputs go through the mixer, big ones are striped           
+   for (Count size : {8, 32, 256, 4096, 65536}) {
+      ::std::string text(size, 'a');
+      for (Offset i = 0; i < size; ++i)
+         text[i] = static_cast<char>('a' + i % 26);
+
+      const auto suffix = "<" + ::std::to_string(size) + " bytes>";
+      bench.Run("HashOf" + suffix, [&] {
+         DoNotOptimize(text);
+         return HashOf(::std::string_view {text});
+      });
+      bench.Run("std::hash" + suffix, [&] {
+         DoNotOptimize(text);
+         return ::std::hash<::std::string_view> {}(text);
+      });
+   }
+
+   {
+      ::std::uint64_t a = 1;
+      double b = 2;
+      ::std::string_view c = "three";
+      bench.Run("HashOf<uint64, double, string_view>", [&] {
+         DoNotOptimize(a);
+         DoNotOptimize(b);
+         DoNotOptimize(c);
+         return HashOf(a, b, c);
+      });
+   }
+}
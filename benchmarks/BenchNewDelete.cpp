@@ -0,0 +1,90 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Main.hpp"
+#include <Core/NewDelete.hpp>
+
+/// Does nothing, unless LANGULUS_FEATURE_NEWDELETE is enabled                
+LANGULUS_MONOPOLIZE_MEMORY()
+
+
+void BenchmarkNewDelete(Benchmark& bench) {
+   // The replacement operators must serve every alignment, that the    
+   // ones they replace serve, including ones bigger than a pool page   
+   for (Offset alignment = 16; alignment <= 1_MiB; alignment *= 2) {
+      for (Offset size : {Offset {10}, Offset {9_KiB}, Offset {200_KiB}}) {
+         const auto memory = Inner::NewDeleteAllocate(size, alignment);
+         Check(memory and reinterpret_cast<Pointer>(memory) % alignment == 0,
+            "NewDeleteAllocate serves any power-of-two alignment");
+         if (memory) {
+            Check(PoolAllocator::SizeOf(memory) >= size,
+               "NewDeleteAllocate serves the requested size");
+            ::std::memset(memory, 0xAB, size);
+         }
+         Inner::NewDeleteFree(memory);
+      }
+   }
+
+   constexpr ::std::align_val_t PageAlignment {64 * 1024};
+   constexpr ::std::align_val_t DoublePageAlignment {128 * 1024};
+   const auto chars = new (PageAlignment) char[10];
+   Check(reinterpret_cast<Pointer>(chars) % (64 * 1024) == 0,
+      "operator new[] serves 64 KiB alignment");
+   operator delete[] (chars, PageAlignment);
+
+   const auto nothrow = new (DoublePageAlignment, ::std::nothrow) char[10];
+   Check(nothrow and reinterpret_cast<Pointer>(nothrow) % (128 * 1024) == 0,
+      "nothrow operator new[] serves 128 KiB alignment");
+   operator delete[] (nothrow, DoublePageAlignment, ::std::nothrow);
+
+   #if LANGULUS_FEATURE(NEWDELETE)
+      // Plain new doesn't have to honor Langulus' alignment, only the  
+      // default one, so that small objects stay small                  
+      const auto small = new char;
+      Check(PoolAllocator::SizeOf(small) <= Roof2(Offset {__STDCPP_DEFAULT_NEW_ALIGNMENT__}),
+         "operator new of a single byte uses no more than the default alignment");
+      delete small;
+   #endif
+
+   // Contents must survive resizing, in place, across size classes,    
+   // and into and out of dedicated pages                               
+   {
+      auto memory = static_cast<unsigned char*>(Inner::NewDeleteAllocate(24));
+      for (Offset i = 0; i < 24; ++i)
+         memory[i] = static_cast<unsigned char>(i);
+
+      bool intact = true;
+      for (Offset size : {Offset {30}, Offset {1_KiB}, Offset {100_KiB}, Offset {24}}) {
+         memory = static_cast<unsigned char*>(Inner::NewDeleteReallocate(memory, size));
+         for (Offset i = 0; i < 24; ++i)
+            intact = intact and memory[i] == static_cast<unsigned char>(i);
+      }
+      Check(intact, "NewDeleteReallocate keeps the contents");
+      Inner::NewDeleteFree(memory);
+   }
+
+   #if LANGULUS_FEATURE(MEMORY_STATISTICS)
+   {
+      const auto memory = Inner::NewDeleteAllocate(100);
+      const auto oldBytes = PoolAllocator::SizeOf(memory);
+      const auto before = MemoryStatistics::Snapshot();
+      const auto resized = Inner::NewDeleteReallocate(memory, 1000);
+      const auto after = MemoryStatistics::Snapshot();
+      Check(after.mReallocations == before.mReallocations + 1,
+         "NewDeleteReallocate is recorded");
+      Check(after.mLiveBytes - before.mLiveBytes == PoolAllocator::SizeOf(resized) - oldBytes,
+         "NewDeleteReallocate accounts for the difference in live bytes");
+      Inner::NewDeleteFree(resized);
+   }
+   #endif
+
+   bench.Run("NewDeleteAllocate+Free<64>", [] {
+      const auto memory = Inner::NewDeleteAllocate(64);
+      DoNotOptimize(memory);
+      Inner::NewDeleteFree(memory);
+   });
+}
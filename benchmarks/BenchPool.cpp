@@ -0,0 +1,99 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Main.hpp"
+#include <Core/Pool.hpp>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Number of allocations, that each thread keeps alive                       
+constexpr Count ChurnLive = 256;
+/// Number of deallocation+allocation pairs, that each thread makes           
+constexpr Count ChurnOperations = 10000;
+
+/// Replace random allocations of 16 to 512 bytes, keeping a fixed number of  
+/// them alive, as containers of small objects usually do                     
+///   @param allocate - allocates a number of bytes                           
+///   @param deallocate - deallocates memory                                  
+///   @param seed - seed for the sizes and the order of replacement           
+///   @return true if all allocations kept their contents                     
+template<class A, class D>
+static bool Churn(A&& allocate, D&& deallocate, ::std::uint32_t seed) {
+   void* live[ChurnLive];
+   ::std::uint8_t tags[ChurnLive];
+   bool intact = true;
+   auto next = [&seed] {
+      seed = seed * 1664525u + 1013904223u;
+      return seed >> 8;
+   };
+
+   for (Offset i = 0; i < ChurnLive; ++i) {
+      live[i] = allocate(16 + next() % 497);
+      tags[i] = static_cast<::std::uint8_t>(i);
+      *static_cast<::std::uint8_t*>(live[i]) = tags[i];
+   }
+
+   for (Offset i = 0; i < ChurnOperations; ++i) {
+      const auto victim = next() % ChurnLive;
+      intact &= *static_cast<::std::uint8_t*>(live[victim]) == tags[victim];
+      deallocate(live[victim]);
+      live[victim] = allocate(16 + next() % 497);
+      tags[victim] = static_cast<::std::uint8_t>(i);
+      *static_cast<::std::uint8_t*>(live[victim]) = tags[victim];
+   }
+
+   for (auto memory : live)
+      deallocate(memory);
+   return intact;
+}
+
+void BenchmarkPool(Benchmark& bench) {
+   // A batch of churn on each thread is one iteration, so that making  
+   // the threads is a negligible part of it                            
+   const auto hardware = ::std::thread::hardware_concurrency();
+   for (Count threads : {Count {1}, Count {hardware > 4 ? 4 : hardware > 2 ? hardware : 2}}) {
+      const auto suffix = "<" + ::std::to_string(threads) + " threads x "
+         + ::std::to_string(ChurnOperations) + " ops>";
+      ::std::atomic<bool> intact = true;
+
+      PageCache cache;
+      bench.Run("PoolAllocator churn" + suffix, [&] {
+         ::std::vector<::std::thread> workers;
+         for (Offset t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+               PoolAllocator pool {&cache};
+               if (not Churn(
+                  [&](Offset size) { return pool.Allocate(size); },
+                  [&](void* memory) { pool.Deallocate(memory); },
+                  static_cast<::std::uint32_t>(t + 1)
+               )) intact = false;
+            });
+         }
+         for (auto& worker : workers)
+            worker.join();
+      });
+
+      bench.Run("malloc churn" + suffix, [&] {
+         ::std::vector<::std::thread> workers;
+         for (Offset t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+               if (not Churn(
+                  [](Offset size) { return ::std::malloc(size); },
+                  [](void* memory) { ::std::free(memory); },
+                  static_cast<::std::uint32_t>(t + 1)
+               )) intact = false;
+            });
+         }
+         for (auto& worker : workers)
+            worker.join();
+      });
+
+      Check(intact, "Churned allocations keep their contents");
+   }
+}
@@ -0,0 +1,87 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Main.hpp"
+
+
+void BenchmarkUtilities(Benchmark& bench) {
+   Check(Roof2(Count {1000}) == 1024, "Roof2(1000) == 1024");
+   Check(DigitsOf(::std::uint64_t {18446744073709551615ull}) == 20, "DigitsOf(uint64 max) == 20");
+   Check(DigitsOf(-12345) == 5, "DigitsOf(-12345) == 5");
+   Check(Align(Count {1000}, Count {64}) == 1024, "Align(1000, 64) == 1024");
+
+   // Inputs change on each iteration, so that nothing is hoisted       
+   // out of the measured loop                                          
+   {
+      ::std::uint32_t x = 1;
+      bench.Run("Roof2<uint32>", [&] {
+         DoNotOptimize(x);
+         return Roof2(x++);
+      });
+   }
+   {
+      ::std::uint64_t x = 1;
+      bench.Run("Roof2<uint64>", [&] {
+         DoNotOptimize(x);
+         return Roof2(x++);
+      });
+   }
+   {
+      ::std::uint32_t x = 0;
+      bench.Run("DigitsOf<uint32>", [&] {
+         DoNotOptimize(x);
+         return DigitsOf(x += 7919);
+      });
+   }
+   {
+      ::std::int64_t x = -1;
+      bench.Run("DigitsOf<int64>", [&] {
+         DoNotOptimize(x);
+         return DigitsOf(x *= 3);
+      });
+   }
+   {
+      Count x = 0;
+      Count alignment = 16;
+      bench.Run("Align<Count>", [&] {
+         DoNotOptimize(x);
+         DoNotOptimize(alignment);
+         return Align(x++, alignment);
+      });
+   }
+
+   // Cast helpers should compile down to nothing                       
+   {
+      int value = 42;
+      int* pointer = &value;
+      bench.Run("DenseCast<int*>", [&] {
+         DoNotOptimize(pointer);
+         return DenseCast(pointer);
+      });
+      bench.Run("SparseCast<int>", [&] {
+         DoNotOptimize(value);
+         return SparseCast(value);
+      });
+   }
+   {
+      float value = 1;
+      bench.Run("ReinterpretCast<float&, uint32>", [&] {
+         DoNotOptimize(value);
+         return ReinterpretCast<::std::uint32_t>(value);
+      });
+   }
+   {
+      const int value = 42;
+      const int* const* pointer = nullptr;
+      const int* inner = &value;
+      pointer = &inner;
+      bench.Run("DecvqCast<const int* const*>", [&] {
+         DoNotOptimize(pointer);
+         return DecvqCast(pointer);
+      });
+   }
+}
@@ -0,0 +1,35 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Main.hpp"
+#include <cstdio>
+
+/// Number of failed checks                                                   
+static int FailedChecks = 0;
+
+void Check(bool condition, const char* what) {
+   if (condition)
+      return;
+
+   ::std::fprintf(stderr, "Check failed: %s\n", what);
+   ++FailedChecks;
+}
+
+int main() {
+   Benchmark bench;
+   BenchmarkUtilities(bench);
+   BenchmarkNewDelete(bench);
+   BenchmarkAlignment(bench);
+   BenchmarkHash(bench);
+   BenchmarkIntegerConversions(bench);
+   BenchmarkRealConversions(bench);
+   BenchmarkPool(bench);
+   BenchmarkFastMath(bench);
+
+   ::std::puts(bench.ToJSON().c_str());
+   return FailedChecks ? 1 : 0;
+}
@@ -0,0 +1,29 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include <Core/Benchmark.hpp>
+
+using namespace Langulus;
+
+
+/// Report the outcome of a correctness check, made along the measurements    
+/// The benchmark executable fails if any of the checks fail, so that the     
+/// suites can be run as a test                                               
+///   @param condition - the outcome of the check                             
+///   @param what - description of what was checked                           
+void Check(bool condition, const char* what);
+
+/// All suites, each of them runs its benchmarks through the given harness    
+void BenchmarkUtilities(Benchmark&);
+void BenchmarkNewDelete(Benchmark&);
+void BenchmarkAlignment(Benchmark&);
+void BenchmarkHash(Benchmark&);
+void BenchmarkIntegerConversions(Benchmark&);
+void BenchmarkRealConversions(Benchmark&);
+void BenchmarkPool(Benchmark&);
+void BenchmarkFastMath(Benchmark&);
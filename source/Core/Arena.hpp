@@ -0,0 +1,295 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Utilities.hpp"
+#include <new>
+
+
+namespace Langulus
+{
+
+   ///                                                                        
+   ///   Monotonic arena allocator                                            
+   ///                                                                        
+   /// Hands out memory by bumping a pointer inside big chained blocks, and   
+   /// never frees individual allocations - instead, the whole arena is       
+   /// rewound to a marker, or reset at once. Blocks are kept for reuse, so   
+   /// after the first frame/request, allocating is just a pointer bump       
+   /// Destructors are never called - use it for trivially destructible       
+   /// types, or destroy the instances manually before rewinding              
+   /// Not thread-safe - use one arena per thread                             
+   ///                                                                        
+   class MonotonicArena {
+   public:
+      static constexpr Size DefaultBlockSize = 64_KiB;
+
+   private:
+      /// A block header, followed by the usable bytes                        
+      struct alignas(Alignment) Block {
+         // The next block in the chain                                 
+         Block* mNext;
+         // Number of usable bytes after the header                     
+         Offset mSize;
+
+         NOD() LANGULUS(ALWAYS_INLINED)
+         Pointer GetStart() const noexcept {
+            return reinterpret_cast<Pointer>(this) + sizeof(Block);
+         }
+
+         NOD() LANGULUS(ALWAYS_INLINED)
+         Pointer GetEnd() const noexcept {
+            return GetStart() + mSize;
+         }
+      };
+
+      static_assert(sizeof(Block) % Alignment == 0,
+         "Usable bytes of a block must start at Alignment");
+
+      // The first block in the chain                                   
+      Block* mFirst {};
+      // The block we're currently allocating from                      
+      Block* mCurrent {};
+      // The first free byte in the current block                       
+      Pointer mCursor {};
+      // The end of the current block                                   
+      Pointer mEnd {};
+      // The usable size of new blocks                                  
+      Offset mBlockSize;
+      // Total usable bytes in all blocks                               
+      Offset mReserved {};
+
+   public:
+      ///                                                                     
+      /// A position inside an arena, that can be rewound to                  
+      ///                                                                     
+      struct Marker {
+         Block* mBlock;
+         Pointer mCursor;
+      };
+
+      ///                                                                     
+      /// Rewinds an arena to where it was upon construction, when going out  
+      /// of scope                                                            
+      ///                                                                     
+      class Scope {
+         MonotonicArena& mArena;
+         Marker mMarker;
+
+      public:
+         Scope() = delete;
+         Scope(const Scope&) = delete;
+         Scope(Scope&&) = delete;
+         Scope& operator = (const Scope&) = delete;
+         Scope& operator = (Scope&&) = delete;
+
+         LANGULUS(INLINED)
+         explicit Scope(MonotonicArena& arena) noexcept
+            : mArena {arena}
+            , mMarker {arena.GetMarker()} {}
+
+         LANGULUS(INLINED)
+         ~Scope() {
+            mArena.Rewind(mMarker);
+         }
+      };
+
+      MonotonicArena(const MonotonicArena&) = delete;
+      MonotonicArena& operator = (const MonotonicArena&) = delete;
+
+      /// Create an arena - no memory is allocated until needed               
+      ///   @param blockSize - the usable size of each block, bigger          
+      ///                      allocations get a dedicated block              
+      LANGULUS(INLINED)
+      explicit MonotonicArena(const Size blockSize = DefaultBlockSize) noexcept
+         : mBlockSize {blockSize} {}
+
+      /// Move an arena, leaving the source empty                             
+      LANGULUS(INLINED)
+      MonotonicArena(MonotonicArena&& other) noexcept
+         : mFirst {other.mFirst}
+         , mCurrent {other.mCurrent}
+         , mCursor {other.mCursor}
+         , mEnd {other.mEnd}
+         , mBlockSize {other.mBlockSize}
+         , mReserved {other.mReserved} {
+         other.mFirst = other.mCurrent = nullptr;
+         other.mCursor = other.mEnd = 0;
+         other.mReserved = 0;
+      }
+
+      /// Move an arena, releasing any memory this one had                    
+      LANGULUS(INLINED)
+      MonotonicArena& operator = (MonotonicArena&& other) noexcept {
+         if (this != &other) {
+            Release();
+            new (this) MonotonicArena {::std::move(other)};
+         }
+         return *this;
+      }
+
+      LANGULUS(INLINED)
+      ~MonotonicArena() {
+         Release();
+      }
+
+      /// Allocate uninitialized bytes                                        
+      ///   @param size - number of bytes to allocate                         
+      ///   @param alignment - the alignment, must be a power-of-two          
+      ///   @return the allocated memory, never nullptr                       
+      ///   @attention throws Except::Allocate if out of memory               
+      NOD() LANGULUS(INLINED)
+      void* Allocate(const Size size, const Offset alignment = Alignment) {
+         #if LANGULUS(SAFE)
+            if (not IsPowerOfTwo(alignment))
+               Throw<Except::Allocate>("Alignment is not a power-of-two", LANGULUS_LOCATION());
+         #endif
+
+         // Compared by what's left, so that huge sizes can't wrap around
+         const auto start = (mCursor + alignment - 1) & ~(alignment - 1);
+         if (mCurrent and start <= mEnd and size <= mEnd - start) LIKELY() {
+            mCursor = start + size;
+            return reinterpret_cast<void*>(start);
+         }
+         return AllocateSlow(size, alignment);
+      }
+
+      /// Allocate uninitialized memory for an array of T                     
+      ///   @param count - number of elements                                 
+      ///   @return the allocated memory, aligned to at least Alignment       
+      ///   @attention throws Except::Allocate if out of memory               
+      template<class T> NOD() LANGULUS(INLINED)
+      T* Allocate(const Count count = 1) {
+         if (count > OffsetMax / sizeof(T)) UNLIKELY()
+            Throw<Except::Allocate>("Arena allocation too big", LANGULUS_LOCATION());
+
+         constexpr Offset align = alignof(T) > Alignment ? alignof(T) : Alignment;
+         return static_cast<T*>(Allocate(sizeof(T) * count, align));
+      }
+
+      /// Allocate and construct an instance of T                             
+      /// Its destructor will never be called by the arena                    
+      ///   @param arguments - arguments to forward to T's constructor        
+      ///   @return the new instance                                          
+      ///   @attention throws Except::Allocate if out of memory               
+      template<class T, class...A> NOD() LANGULUS(INLINED)
+      T* New(A&&...arguments) {
+         return new (Allocate<T>()) T (::std::forward<A>(arguments)...);
+      }
+
+      /// Get the current position, that can be rewound to later              
+      ///   @return the marker                                                
+      NOD() LANGULUS(INLINED)
+      Marker GetMarker() const noexcept {
+         return {mCurrent, mCursor};
+      }
+
+      /// Rewind to a previously retrieved marker, invalidating anything      
+      /// that was allocated after it                                         
+      /// The blocks are kept, so they're reused by later allocations         
+      ///   @param marker - the marker to rewind to                           
+      LANGULUS(INLINED)
+      void Rewind(const Marker& marker) noexcept {
+         if (marker.mBlock) {
+            mCurrent = marker.mBlock;
+            mCursor = marker.mCursor;
+            mEnd = mCurrent->GetEnd();
+         }
+         else Reset();
+      }
+
+      /// Rewind to the start, invalidating all allocations, but keeping the  
+      /// blocks for reuse                                                    
+      LANGULUS(INLINED)
+      void Reset() noexcept {
+         mCurrent = mFirst;
+         if (mCurrent) {
+            mCursor = mCurrent->GetStart();
+            mEnd = mCurrent->GetEnd();
+         }
+      }
+
+      /// Free all blocks, invalidating all allocations                       
+      void Release() noexcept {
+         while (mFirst) {
+            const auto next = mFirst->mNext;
+            ::operator delete(mFirst, ::std::align_val_t {alignof(Block)});
+            mFirst = next;
+         }
+
+         mCurrent = nullptr;
+         mCursor = mEnd = 0;
+         mReserved = 0;
+      }
+
+      /// Get the number of usable bytes in all blocks                        
+      NOD() LANGULUS(INLINED)
+      Size GetReserved() const noexcept {
+         return mReserved;
+      }
+
+      /// Get the usable size of new blocks                                   
+      NOD() LANGULUS(INLINED)
+      Size GetBlockSize() const noexcept {
+         return mBlockSize;
+      }
+
+   private:
+      /// Continue in the next block that can fit an allocation, or chain a   
+      /// new block after the current one                                     
+      NOD() LANGULUS(NOINLINE)
+      void* AllocateSlow(const Offset size, const Offset alignment) {
+         // Reuse the blocks that were kept by Rewind/Reset             
+         auto next = mCurrent ? mCurrent->mNext : mFirst;
+         while (next) {
+            const auto start = (next->GetStart() + alignment - 1) & ~(alignment - 1);
+            if (start <= next->GetEnd() and size <= next->GetEnd() - start)
+               return Continue(next, start, size);
+            next = next->mNext;
+         }
+
+         // Blocks are aligned to Alignment, anything over that has to  
+         // be padded                                                   
+         const Offset padding = alignment > alignof(Block) ? alignment - alignof(Block) : 0;
+         if (size > OffsetMax - sizeof(Block) - padding)
+            Throw<Except::Allocate>("Arena allocation too big", LANGULUS_LOCATION());
+
+         const Offset usable = size + padding > mBlockSize
+            ? size + padding : mBlockSize;
+         const auto memory = ::operator new(sizeof(Block) + usable,
+            ::std::align_val_t {alignof(Block)}, ::std::nothrow);
+         if (not memory)
+            Throw<Except::Allocate>("Out of memory", LANGULUS_LOCATION());
+
+         // Chain it right after the current block, so that later       
+         // rewinds reach it in allocation order                        
+         const auto block = new (memory) Block {nullptr, usable};
+         if (mCurrent) {
+            block->mNext = mCurrent->mNext;
+            mCurrent->mNext = block;
+         }
+         else {
+            block->mNext = mFirst;
+            mFirst = block;
+         }
+
+         mReserved += usable;
+         const auto start = (block->GetStart() + alignment - 1) & ~(alignment - 1);
+         return Continue(block, start, size);
+      }
+
+      /// Switch to a block, and allocate from it                             
+      LANGULUS(INLINED)
+      void* Continue(Block* block, const Pointer start, const Offset size) noexcept {
+         mCurrent = block;
+         mCursor = start + size;
+         mEnd = block->GetEnd();
+         return reinterpret_cast<void*>(start);
+      }
+   };
+
+} // namespace Langulus
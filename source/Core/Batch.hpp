@@ -0,0 +1,195 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <memory>
+#include <array>
+
+
+namespace Langulus
+{
+   namespace Inner
+   {
+
+      /// Destroy elements in reverse, used to roll back a batch, that threw  
+      ///   @param what - the first element                                   
+      ///   @param count - number of elements, that were constructed          
+      template<CT::Dense T>
+      constexpr void BatchRollback(T* what, Count count) noexcept {
+         while (count)
+            ::std::destroy_at(what + --count);
+      }
+
+      /// Construct elements one by one, destroying the constructed ones, if  
+      /// any of them throws, so that the batch either fully succeeds, or     
+      /// leaves no elements behind                                           
+      ///   @param to - the first uninitialized element                       
+      ///   @param count - number of elements                                 
+      ///   @param construct - constructs element i                           
+      template<CT::Dense T, class F>
+      constexpr void BatchEach(T* to, const Count count, F&& construct)
+      noexcept(noexcept(construct(Offset {}))) {
+         if constexpr (LANGULUS(EXCEPTIONS) and not noexcept(construct(Offset {}))) {
+            Offset i = 0;
+            try {
+               for (; i < count; ++i)
+                  construct(i);
+            }
+            catch (...) {
+               BatchRollback(to, i);
+               throw;
+            }
+         }
+         else for (Offset i = 0; i < count; ++i)
+            construct(i);
+      }
+
+      /// Check if T can be compared without throwing                         
+      template<class T>
+      concept NothrowComparable = requires (const T& a) {
+         {a == a} noexcept;
+      };
+
+   } // namespace Langulus::Inner
+
+
+   /// Default-construct elements in uninitialized memory                     
+   /// Nullifiable types are zeroed in bulk, others are value-initialized one 
+   /// by one - if any of them throws, the constructed ones are destroyed     
+   ///   @param to - the first uninitialized element                          
+   ///   @param count - number of elements                                    
+   template<CT::Dense T> LANGULUS(INLINED)
+   constexpr void BatchConstruct(T* to, const Count count)
+   noexcept(::std::is_nothrow_default_constructible_v<T> or CT::Inner::Nullifiable<T>) {
+      if constexpr (CT::Inner::Nullifiable<T>) {
+         IF_CONSTEXPR() {
+            for (Offset i = 0; i < count; ++i)
+               ::std::construct_at(to + i);
+         }
+         else if (count)
+            ::std::memset(static_cast<void*>(to), 0, count * sizeof(T));
+      }
+      else {
+         static_assert(::std::is_default_constructible_v<T>,
+            "T is not default-constructible");
+         Inner::BatchEach(to, count, [to](const Offset i)
+         noexcept(::std::is_nothrow_default_constructible_v<T>) {
+            ::std::construct_at(to + i);
+         });
+      }
+   }
+
+   /// Copy-construct elements in uninitialized memory                        
+   /// POD types are copied in bulk, others are copy-constructed one by one - 
+   /// if any of them throws, the constructed ones are destroyed              
+   ///   @param from - the elements to copy                                   
+   ///   @param to - the first uninitialized element, must not overlap from   
+   ///   @param count - number of elements                                    
+   template<CT::Dense T> LANGULUS(INLINED)
+   constexpr void BatchCopy(const T* from, T* to, const Count count)
+   noexcept(::std::is_nothrow_copy_constructible_v<T> or CT::Inner::POD<T>) {
+      if constexpr (CT::Inner::POD<T>) {
+         IF_CONSTEXPR() {
+            for (Offset i = 0; i < count; ++i)
+               ::std::construct_at(to + i, from[i]);
+         }
+         else if (count)
+            ::std::memcpy(static_cast<void*>(to), from, count * sizeof(T));
+      }
+      else {
+         static_assert(::std::is_copy_constructible_v<T>,
+            "T is not copy-constructible");
+         Inner::BatchEach(to, count, [from, to](const Offset i)
+         noexcept(::std::is_nothrow_copy_constructible_v<T>) {
+            ::std::construct_at(to + i, from[i]);
+         });
+      }
+   }
+
+   /// Move-construct elements in uninitialized memory                        
+   /// POD types are copied in bulk, others are move-constructed one by one - 
+   /// if any of them throws, the constructed ones are destroyed. The source  
+   /// elements are left in their moved-from state, and still have to be      
+   /// destroyed                                                              
+   ///   @param from - the elements to move                                   
+   ///   @param to - the first uninitialized element, must not overlap from   
+   ///   @param count - number of elements                                    
+   template<CT::Dense T> LANGULUS(INLINED)
+   constexpr void BatchMove(T* from, T* to, const Count count)
+   noexcept(::std::is_nothrow_move_constructible_v<T> or CT::Inner::POD<T>) {
+      if constexpr (CT::Inner::POD<T>) {
+         IF_CONSTEXPR() {
+            for (Offset i = 0; i < count; ++i)
+               ::std::construct_at(to + i, ::std::move(from[i]));
+         }
+         else if (count)
+            ::std::memcpy(static_cast<void*>(to), from, count * sizeof(T));
+      }
+      else {
+         static_assert(::std::is_move_constructible_v<T>,
+            "T is not move-constructible");
+         Inner::BatchEach(to, count, [from, to](const Offset i)
+         noexcept(::std::is_nothrow_move_constructible_v<T>) {
+            ::std::construct_at(to + i, ::std::move(from[i]));
+         });
+      }
+   }
+
+   /// Destroy elements, leaving their memory uninitialized                   
+   /// POD and trivially destructible types have nothing to destroy           
+   ///   @param what - the first element                                      
+   ///   @param count - number of elements                                    
+   template<CT::Dense T> LANGULUS(INLINED)
+   constexpr void BatchDestroy(T* what, const Count count) noexcept {
+      if constexpr (not CT::Inner::POD<T> and not ::std::is_trivially_destructible_v<T>) {
+         for (Offset i = 0; i < count; ++i)
+            ::std::destroy_at(what + i);
+      }
+   }
+
+   /// Compare elements for equality                                          
+   /// Elements are compared in bulk only if equal values always have equal   
+   /// bytes - see CT::Inner::BytewiseComparable. Anything else, like reals,  
+   /// where -0 equals 0 and NaN equals nothing, or types with padding, is    
+   /// compared one by one with ==, so that the result is the same as with    
+   /// ==, both at compile-time and at runtime                                
+   ///   @param lhs - the left elements                                       
+   ///   @param rhs - the right elements                                      
+   ///   @param count - number of elements                                    
+   ///   @return true if all elements are equal                               
+   template<CT::Dense T> NOD() LANGULUS(INLINED)
+   constexpr bool BatchCompare(const T* lhs, const T* rhs, const Count count)
+   noexcept(CT::Inner::BytewiseComparable<T> or Inner::NothrowComparable<T>) {
+      constexpr bool Bytewise = CT::Inner::BytewiseComparable<T>;
+      if constexpr (Bytewise) {
+         IF_CONSTEXPR() {}
+         else {
+            return lhs == rhs or not count
+                or ::std::memcmp(lhs, rhs, count * sizeof(T)) == 0;
+         }
+      }
+
+      if constexpr (Bytewise and not CT::Comparable<T, T>) {
+         // Compile-time fallback for POD types without an == operator  
+         using Bytes = ::std::array<unsigned char, sizeof(T)>;
+         for (Offset i = 0; i < count; ++i) {
+            if (::std::bit_cast<Bytes>(lhs[i]) != ::std::bit_cast<Bytes>(rhs[i]))
+               return false;
+         }
+      }
+      else {
+         static_assert(CT::Comparable<T, T>, "T is not equality-comparable");
+         for (Offset i = 0; i < count; ++i) {
+            if (not (lhs[i] == rhs[i]))
+               return false;
+         }
+      }
+      return true;
+   }
+
+} // namespace Langulus
@@ -0,0 +1,279 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Conversions.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+
+
+namespace Langulus
+{
+
+   namespace Inner
+   {
+
+      /// Where DoNotOptimize publishes addresses on compilers without inline 
+      /// assembly - writing to a volatile makes the value observable         
+      inline const volatile void* volatile BenchmarkSink {};
+
+      /// Escape a name for a JSON string                                     
+      ///   @param out - where to append the escaped name                     
+      ///   @param name - the name to escape                                  
+      LANGULUS(INLINED)
+      void BenchmarkEscape(::std::string& out, const Token& name) {
+         constexpr Letter hex[] = "0123456789abcdef";
+         for (const auto c : name) {
+            if (c == '"' or c == '\\') {
+               out += '\\';
+               out += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20) {
+               out += "\\u00";
+               out += hex[static_cast<unsigned char>(c) >> 4];
+               out += hex[c & 0xF];
+            }
+            else out += c;
+         }
+      }
+
+      /// Append a number to a JSON string                                    
+      template<class T> LANGULUS(INLINED)
+      void BenchmarkNumber(::std::string& out, const T value) {
+         Letter buffer[MaxCharsOf<T>];
+         out.append(buffer, ToChars(buffer, value));
+      }
+
+   } // namespace Langulus::Inner
+
+
+   /// Force the compiler to compute a value, as if it was read by something  
+   /// outside the program, without actually reading it                       
+   ///   @param value - the value to keep                                     
+   template<class T> LANGULUS(ALWAYS_INLINED)
+   void DoNotOptimize(const T& value) noexcept {
+      #if LANGULUS_COMPILER(GCC) or LANGULUS_COMPILER(CLANG)
+         asm volatile("" : : "r,m"(value) : "memory");
+      #else
+         Inner::BenchmarkSink = &value;
+      #endif
+   }
+
+   /// Force the compiler to compute a value, and to forget what it knows     
+   /// about it, as if it was modified by something outside the program       
+   ///   @param value - the value to keep                                     
+   template<class T> LANGULUS(ALWAYS_INLINED)
+   void DoNotOptimize(T& value) noexcept {
+      #if LANGULUS_COMPILER(GCC) or LANGULUS_COMPILER(CLANG)
+         asm volatile("" : "+r,m"(value) : : "memory");
+      #else
+         Inner::BenchmarkSink = &value;
+      #endif
+   }
+
+   /// Force the compiler to commit all pending writes to memory              
+   LANGULUS(ALWAYS_INLINED)
+   void ClobberMemory() noexcept {
+      #if LANGULUS_COMPILER(GCC) or LANGULUS_COMPILER(CLANG)
+         asm volatile("" : : : "memory");
+      #else
+         ::std::atomic_signal_fence(::std::memory_order_seq_cst);
+      #endif
+   }
+
+   ///                                                                        
+   ///   Measurements of a single benchmark                                   
+   ///                                                                        
+   /// All times are in nanoseconds per iteration                             
+   ///                                                                        
+   struct BenchmarkResult {
+      ::std::string mName;
+      // Number of iterations in each sample                            
+      Count mIterations {};
+      // Number of measured samples                                     
+      Count mSamples {};
+      double mMin {};
+      double mMedian {};
+      double mP99 {};
+      double mMean {};
+      double mMax {};
+   };
+
+   ///                                                                        
+   ///   Microbenchmark harness                                               
+   ///                                                                        
+   /// Runs a function in a loop, until a batch of iterations takes at least  
+   /// the sample time, then warms up with such batches, and finally measures 
+   /// a number of them. Results are reported per iteration, so cheap         
+   /// functions are measured as precisely as expensive ones                  
+   /// Wrap the inputs and outputs of the measured code in DoNotOptimize, or  
+   /// the compiler may compute them once, or not at all:                     
+   ///                                                                        
+   ///   Benchmark bench;                                                     
+   ///   Count x = 1000;                                                      
+   ///   bench.Run("Roof2", [&] {                                             
+   ///      DoNotOptimize(x);                                                 
+   ///      return Roof2(x);                                                  
+   ///   });                                                                  
+   ///   puts(bench.ToJSON().c_str());                                        
+   ///                                                                        
+   class Benchmark {
+   public:
+      using Clock = ::std::chrono::steady_clock;
+      using Duration = ::std::chrono::nanoseconds;
+
+      static constexpr Count DefaultSamples = 100;
+      static constexpr Duration DefaultSampleTime = ::std::chrono::milliseconds {1};
+      static constexpr Duration DefaultWarmup = ::std::chrono::milliseconds {50};
+      // Functions that the compiler optimized away never reach the     
+      // sample time, so calibration stops here                         
+      static constexpr Count MaxIterations = Count {1} << 30;
+
+   private:
+      // Number of samples to measure                                   
+      Count mSamples;
+      // Minimum duration of a sample                                   
+      Duration mSampleTime;
+      // How long to run before measuring                               
+      Duration mWarmup;
+      // All results so far, in the order of running                    
+      ::std::vector<BenchmarkResult> mResults;
+
+   public:
+      /// Create a benchmark harness                                          
+      ///   @param samples - number of samples to measure, at least one       
+      ///   @param sampleTime - minimum duration of each sample - iterations  
+      ///                       are calibrated so that they take that long    
+      ///   @param warmup - how long to run the function before measuring     
+      LANGULUS(INLINED)
+      explicit Benchmark(
+         const Count samples = DefaultSamples,
+         const Duration sampleTime = DefaultSampleTime,
+         const Duration warmup = DefaultWarmup
+      ) noexcept
+         : mSamples {samples ? samples : 1}
+         , mSampleTime {sampleTime}
+         , mWarmup {warmup} {}
+
+      /// Measure a function                                                  
+      /// If the function returns a value, it is passed to DoNotOptimize      
+      ///   @param name - name of the benchmark, as reported                  
+      ///   @param call - the function to measure, called once per iteration  
+      ///   @return a copy of the measurements, that stays valid after later  
+      ///           runs, unlike anything in GetResults()                     
+      template<class F>
+      BenchmarkResult Run(const Token& name, F&& call) {
+         // Calibrate the number of iterations in a sample, aiming a    
+         // bit over the sample time, so that we rarely have to retry   
+         Count iterations = 1;
+         while (iterations < MaxIterations) {
+            const auto elapsed = Measure(call, iterations);
+            if (elapsed >= mSampleTime)
+               break;
+
+            const auto wanted = elapsed.count() > 0
+               ? iterations * 1.2 * mSampleTime.count() / elapsed.count()
+               : iterations * 10.0;
+            iterations = ::std::min(MaxIterations, ::std::max(iterations * 2,
+               static_cast<Count>(::std::min(wanted, iterations * 100.0))));
+         }
+
+         // Warm up caches, branch predictors and clock frequency       
+         Duration warmed {};
+         while (warmed < mWarmup)
+            warmed += Measure(call, iterations);
+
+         ::std::vector<double> samples(mSamples);
+         for (auto& sample : samples)
+            sample = static_cast<double>(Measure(call, iterations).count()) / iterations;
+         ::std::sort(samples.begin(), samples.end());
+
+         double sum = 0;
+         for (auto sample : samples)
+            sum += sample;
+
+         // The 99th percentile uses the nearest-rank method            
+         const auto p99 = (mSamples * 99 + 99) / 100 - 1;
+         auto& result = mResults.emplace_back();
+         result.mName = name;
+         result.mIterations = iterations;
+         result.mSamples = mSamples;
+         result.mMin = samples.front();
+         result.mMedian = mSamples % 2
+            ? samples[mSamples / 2]
+            : (samples[mSamples / 2 - 1] + samples[mSamples / 2]) / 2;
+         result.mP99 = samples[p99];
+         result.mMean = sum / mSamples;
+         result.mMax = samples.back();
+         return result;
+      }
+
+      /// Get all results so far, in the order of running                     
+      NOD() LANGULUS(INLINED)
+      const ::std::vector<BenchmarkResult>& GetResults() const noexcept {
+         return mResults;
+      }
+
+      /// Forget all results                                                  
+      LANGULUS(INLINED)
+      void Clear() noexcept {
+         mResults.clear();
+      }
+
+      /// Write all results as JSON, in the form:                             
+      /// {"benchmarks": [{"name": "...", "iterations": 1, "samples": 1,      
+      ///   "min_ns": 1, "median_ns": 1, "p99_ns": 1, "mean_ns": 1,           
+      ///   "max_ns": 1}, ...]}                                               
+      ///   @return the JSON text                                             
+      NOD() ::std::string ToJSON() const {
+         ::std::string out = "{\"benchmarks\": [";
+         for (const auto& result : mResults) {
+            if (&result != mResults.data())
+               out += ", ";
+
+            out += "{\"name\": \"";
+            Inner::BenchmarkEscape(out, result.mName);
+            out += "\", \"iterations\": ";
+            Inner::BenchmarkNumber(out, result.mIterations);
+            out += ", \"samples\": ";
+            Inner::BenchmarkNumber(out, result.mSamples);
+            out += ", \"min_ns\": ";
+            Inner::BenchmarkNumber(out, result.mMin);
+            out += ", \"median_ns\": ";
+            Inner::BenchmarkNumber(out, result.mMedian);
+            out += ", \"p99_ns\": ";
+            Inner::BenchmarkNumber(out, result.mP99);
+            out += ", \"mean_ns\": ";
+            Inner::BenchmarkNumber(out, result.mMean);
+            out += ", \"max_ns\": ";
+            Inner::BenchmarkNumber(out, result.mMax);
+            out += '}';
+         }
+         out += "]}";
+         return out;
+      }
+
+   private:
+      /// Call a function a number of times, and measure how long it took     
+      template<class F> NOD() LANGULUS(NOINLINE)
+      static Duration Measure(F& call, const Count iterations) {
+         const auto start = Clock::now();
+         for (Count i = 0; i < iterations; ++i) {
+            if constexpr (requires { { call() } -> CT::Void; })
+               call();
+            else
+               DoNotOptimize(call());
+         }
+         ClobberMemory();
+         return ::std::chrono::duration_cast<Duration>(Clock::now() - start);
+      }
+   };
+
+} // namespace Langulus
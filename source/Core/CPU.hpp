@@ -0,0 +1,371 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <cstdio>
+#include <thread>
+
+#if LANGULUS_ARCH(X86)
+   #if LANGULUS_COMPILER(MSVC)
+      #include <intrin.h>
+   #else
+      #include <cpuid.h>
+   #endif
+#endif
+
+#if LANGULUS_OS(MACOS)
+   #include <sys/sysctl.h>
+#endif
+
+
+namespace Langulus
+{
+
+   namespace Inner
+   {
+
+   #if LANGULUS_ARCH(X86)
+      /// Registers returned by the CPUID instruction                         
+      struct CPUIDRegisters {
+         ::std::uint32_t eax, ebx, ecx, edx;
+      };
+
+      /// Execute the CPUID instruction                                       
+      ///   @param leaf - the leaf to query                                   
+      ///   @param subleaf - the subleaf to query                             
+      ///   @return the registers                                             
+      NOD() LANGULUS(INLINED)
+      CPUIDRegisters CPUID(const ::std::uint32_t leaf, const ::std::uint32_t subleaf = 0) noexcept {
+         CPUIDRegisters r;
+         #if LANGULUS_COMPILER(MSVC)
+            int regs[4];
+            __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+            r.eax = static_cast<::std::uint32_t>(regs[0]);
+            r.ebx = static_cast<::std::uint32_t>(regs[1]);
+            r.ecx = static_cast<::std::uint32_t>(regs[2]);
+            r.edx = static_cast<::std::uint32_t>(regs[3]);
+         #else
+            __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+         #endif
+         return r;
+      }
+
+      /// Read the register, that tells which vector states the OS saves on   
+      /// context switches - without it, wide registers can't be used, even   
+      /// if the CPU has them                                                 
+      ///   @return the XCR0 register                                         
+      NOD() LANGULUS(INLINED)
+      ::std::uint64_t XGETBV() noexcept {
+         #if LANGULUS_COMPILER(MSVC)
+            return _xgetbv(0);
+         #else
+            ::std::uint32_t lo, hi;
+            asm volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            return (static_cast<::std::uint64_t>(hi) << 32) | lo;
+         #endif
+      }
+   #endif
+
+   #if LANGULUS_OS(LINUX) or LANGULUS_OS(ANDROID)
+      /// Read the first number from a sysfs file                             
+      ///   @param path - the file                                            
+      ///   @param suffix - if not null, receives the letter after the number,
+      ///                   like the K in "32K"                               
+      ///   @return the number, or zero if the file can't be read             
+      NOD() inline Offset ReadSysfs(const char* path, char* suffix = nullptr) noexcept {
+         const auto file = ::std::fopen(path, "r");
+         if (not file)
+            return 0;
+
+         unsigned long long number = 0;
+         char letter = 0;
+         if (::std::fscanf(file, "%llu%c", &number, &letter) < 1)
+            number = 0;
+         ::std::fclose(file);
+         if (suffix)
+            *suffix = letter;
+         return static_cast<Offset>(number);
+      }
+   #endif
+
+   #if LANGULUS_OS(MACOS)
+      /// Read a number via sysctl                                            
+      ///   @param name - the name of the value                               
+      ///   @return the number, or zero if not available                      
+      NOD() inline Offset ReadSysctl(const char* name) noexcept {
+         ::std::int64_t number = 0;
+         ::std::size_t size = sizeof(number);
+         if (sysctlbyname(name, &number, &size, nullptr, 0) != 0)
+            return 0;
+         return size == sizeof(::std::int32_t)
+            ? static_cast<Offset>(*reinterpret_cast<::std::int32_t*>(&number))
+            : static_cast<Offset>(number);
+      }
+   #endif
+
+   } // namespace Langulus::Inner
+
+
+   ///                                                                        
+   ///   The processor the program runs on                                    
+   ///                                                                        
+   /// Unlike LANGULUS_SIMD, which tells what the code was built with, this   
+   /// tells what the host machine actually supports, so that allocators,     
+   /// thread pools and kernels can tune themselves to it. Detection is not   
+   /// cheap - use CPU::Get(), which detects only once                        
+   /// Instruction sets are reported only if the OS supports them, too        
+   ///                                                                        
+   struct CPU {
+      // x86 instruction set extensions                                 
+      bool mSSE2 {};
+      bool mSSE41 {};
+      bool mSSE42 {};
+      bool mPOPCNT {};
+      bool mAVX {};
+      bool mAVX2 {};
+      bool mFMA {};
+      bool mF16C {};
+      bool mBMI1 {};
+      bool mBMI2 {};
+      // AVX-512 foundation and byte/word instructions, same as what    
+      // LANGULUS_SIMD(AVX512) requires                                 
+      bool mAVX512 {};
+      // ARM instruction set extensions                                 
+      bool mNEON {};
+
+      // Size of a cache line in bytes                                  
+      Offset mCacheLine {CacheLine};
+      // Size of a single core's L1 data cache in bytes, zero if unknown
+      Offset mL1 {};
+      // Size of the L2 cache in bytes, zero if unknown                 
+      Offset mL2 {};
+      // Size of the L3 cache in bytes, zero if unknown                 
+      Offset mL3 {};
+
+      // Number of physical cores                                       
+      Count mCores {1};
+      // Number of hardware threads - more than cores, if SMT is on     
+      Count mThreads {1};
+
+      /// Detect the host processor                                           
+      /// Can be called before static initialization, but is slow, because it 
+      /// may read files - prefer Get(), unless you need it that early        
+      ///   @return the detected processor                                    
+      NOD() LANGULUS(NOINLINE)
+      static CPU Detect() noexcept {
+         CPU result;
+         result.DetectInstructionSets();
+         result.DetectTopology();
+         result.DetectCaches();
+         return result;
+      }
+
+      /// Get the host processor, detecting it on first call                  
+      ///   @return the processor                                             
+      NOD() LANGULUS(INLINED)
+      static const CPU& Get() noexcept {
+         static const CPU cached = Detect();
+         return cached;
+      }
+
+   private:
+      /// Detect instruction sets that both the CPU and the OS support        
+      inline void DetectInstructionSets() noexcept {
+      #if LANGULUS_ARCH(X86)
+         const auto maxLeaf = Inner::CPUID(0).eax;
+         if (maxLeaf < 1)
+            return;
+
+         const auto leaf1 = Inner::CPUID(1);
+         mSSE2   = leaf1.edx & (1u << 26);
+         mSSE41  = leaf1.ecx & (1u << 19);
+         mSSE42  = leaf1.ecx & (1u << 20);
+         mPOPCNT = leaf1.ecx & (1u << 23);
+
+         // AVX registers are usable only if the OS saves them          
+         const bool osxsave = leaf1.ecx & (1u << 27);
+         const auto xcr0 = osxsave ? Inner::XGETBV() : 0;
+         const bool avxState = (xcr0 & 0x06) == 0x06;
+         const bool avx512State = (xcr0 & 0xE6) == 0xE6;
+         mAVX = avxState and (leaf1.ecx & (1u << 28));
+         mFMA = mAVX and (leaf1.ecx & (1u << 12));
+         mF16C = mAVX and (leaf1.ecx & (1u << 29));
+
+         if (maxLeaf < 7)
+            return;
+
+         const auto leaf7 = Inner::CPUID(7);
+         mBMI1   = leaf7.ebx & (1u << 3);
+         mAVX2   = mAVX and (leaf7.ebx & (1u << 5));
+         mBMI2   = leaf7.ebx & (1u << 8);
+         mAVX512 = avx512State
+               and (leaf7.ebx & (1u << 16))
+               and (leaf7.ebx & (1u << 30));
+      #elif LANGULUS_ARCH(ARM)
+         // NEON is mandatory on 64-bit ARM, and must be enabled at     
+         // compile-time on 32-bit ARM, because it's not always there   
+         mNEON = Bitness == 64 or LANGULUS_SIMD(NEON);
+      #endif
+      }
+
+      /// Detect the number of cores and hardware threads                     
+      inline void DetectTopology() noexcept {
+         const auto threads = ::std::thread::hardware_concurrency();
+         mThreads = threads ? threads : 1;
+         mCores = mThreads;
+
+      #if LANGULUS_OS(LINUX) or LANGULUS_OS(ANDROID)
+         // Every core is counted once - by its first hardware thread   
+         Count cores = 0;
+         Count found = 0;
+         Count misses = 0;
+         for (unsigned i = 0; found < mThreads and misses < 64; ++i) {
+            char path[96];
+            ::std::snprintf(path, sizeof(path),
+               "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", i);
+            const auto file = ::std::fopen(path, "r");
+            if (not file) {
+               ++misses;
+               continue;
+            }
+
+            unsigned first = 0;
+            if (::std::fscanf(file, "%u", &first) == 1 and first == i)
+               ++cores;
+            ::std::fclose(file);
+            ++found;
+            misses = 0;
+         }
+
+         if (cores) {
+            mCores = cores;
+            return;
+         }
+      #elif LANGULUS_OS(MACOS)
+         const auto cores = Inner::ReadSysctl("hw.physicalcpu");
+         if (cores) {
+            mCores = cores;
+            return;
+         }
+      #endif
+
+      #if LANGULUS_ARCH(X86)
+         // Fall back to the number of threads per core, as reported by 
+         // the extended topology leaf                                  
+         if (Inner::CPUID(0).eax >= 0xB) {
+            const auto smt = Inner::CPUID(0xB, 0);
+            const auto perCore = smt.ebx & 0xFFFF;
+            if (((smt.ecx >> 8) & 0xFF) == 1 and perCore > 1)
+               mCores = mThreads / perCore ? mThreads / perCore : 1;
+         }
+      #endif
+      }
+
+      /// Detect cache sizes and the cache line                               
+      inline void DetectCaches() noexcept {
+      #if LANGULUS_OS(LINUX) or LANGULUS_OS(ANDROID)
+         for (unsigned i = 0; i < 16; ++i) {
+            char path[96];
+            ::std::snprintf(path, sizeof(path),
+               "/sys/devices/system/cpu/cpu0/cache/index%u/level", i);
+            const auto level = Inner::ReadSysfs(path);
+            if (not level)
+               break;
+
+            // Skip instruction caches                                  
+            ::std::snprintf(path, sizeof(path),
+               "/sys/devices/system/cpu/cpu0/cache/index%u/type", i);
+            const auto file = ::std::fopen(path, "r");
+            if (not file)
+               continue;
+            const bool instruction = ::std::fgetc(file) == 'I';
+            ::std::fclose(file);
+            if (instruction)
+               continue;
+
+            char unit = 0;
+            ::std::snprintf(path, sizeof(path),
+               "/sys/devices/system/cpu/cpu0/cache/index%u/size", i);
+            auto size = Inner::ReadSysfs(path, &unit);
+            if (unit == 'K')
+               size *= 1024;
+            else if (unit == 'M')
+               size *= 1024 * 1024;
+            SetCache(level, size);
+
+            if (level == 1) {
+               ::std::snprintf(path, sizeof(path),
+                  "/sys/devices/system/cpu/cpu0/cache/index%u/coherency_line_size", i);
+               if (const auto line = Inner::ReadSysfs(path))
+                  mCacheLine = line;
+            }
+         }
+
+         if (mL1)
+            return;
+      #elif LANGULUS_OS(MACOS)
+         if (const auto line = Inner::ReadSysctl("hw.cachelinesize"))
+            mCacheLine = line;
+         mL1 = Inner::ReadSysctl("hw.l1dcachesize");
+         mL2 = Inner::ReadSysctl("hw.l2cachesize");
+         mL3 = Inner::ReadSysctl("hw.l3cachesize");
+         if (mL1)
+            return;
+      #endif
+
+      #if LANGULUS_ARCH(X86)
+         // Fall back to the deterministic cache parameters - leaf 4 on 
+         // Intel, and the same layout at 0x8000001D on AMD             
+         const auto maxLeaf = Inner::CPUID(0).eax;
+         if (maxLeaf >= 1)
+            mCacheLine = ((Inner::CPUID(1).ebx >> 8) & 0xFF) * 8;
+         if (maxLeaf >= 4)
+            DetectCachesFromLeaf(4);
+         if (not mL1 and Inner::CPUID(0x80000000).eax >= 0x8000001D)
+            DetectCachesFromLeaf(0x8000001D);
+         if (not mCacheLine)
+            mCacheLine = CacheLine;
+      #endif
+      }
+
+   #if LANGULUS_ARCH(X86)
+      /// Detect data and unified caches via a deterministic cache leaf       
+      ///   @param leaf - the leaf to enumerate                               
+      inline void DetectCachesFromLeaf(const ::std::uint32_t leaf) noexcept {
+         for (::std::uint32_t i = 0; i < 16; ++i) {
+            const auto r = Inner::CPUID(leaf, i);
+            const auto type = r.eax & 0x1F;
+            if (type == 0)
+               break;
+            if (type == 2)
+               continue;
+
+            const Offset ways       = ((r.ebx >> 22) & 0x3FF) + 1;
+            const Offset partitions = ((r.ebx >> 12) & 0x3FF) + 1;
+            const Offset line       = (r.ebx & 0xFFF) + 1;
+            const Offset sets       = Offset {r.ecx} + 1;
+            SetCache((r.eax >> 5) & 0x7, ways * partitions * line * sets);
+         }
+      }
+   #endif
+
+      /// Remember the size of a data or unified cache                        
+      ///   @param level - the cache level, starting at 1                     
+      ///   @param size - the size in bytes                                   
+      LANGULUS(INLINED)
+      void SetCache(const Offset level, const Offset size) noexcept {
+         switch (level) {
+         case 1: mL1 = size; break;
+         case 2: mL2 = size; break;
+         case 3: mL3 = size; break;
+         default: break;
+         }
+      }
+   };
+
+} // namespace Langulus
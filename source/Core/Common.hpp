@@ -129,6 +129,7 @@ namespace Langulus
    struct Hash {
       static constexpr bool CTTI_POD = true;
       static constexpr bool CTTI_Nullifiable = true;
+      static constexpr bool CTTI_BytewiseComparable = true;
 
       ::std::size_t mHash {};
 
@@ -191,14 +192,48 @@ namespace Langulus
    /// True if the architecture uses little/mixed endianness                  
    constexpr bool LittleEndianMachine = ::std::endian::native == ::std::endian::little;
 
+   /// The width of the widest registers, that the code was built for         
+   constexpr Offset SimdWidth = LANGULUS_SIMD(AVX512) ? 64
+                              : LANGULUS_SIMD(AVX) ? 32
+                              : LANGULUS_SIMD(SSE2) or LANGULUS_SIMD(NEON) ? 16
+                              : 0;
+
+   // CMake sets it for all targets at once, so that all of them agree  
+   // on it, even if built with different flags                         
    #ifndef LANGULUS_ALIGNMENT
-      #define LANGULUS_ALIGNMENT 16
+      #if LANGULUS_SIMD(AVX512)
+         #define LANGULUS_ALIGNMENT 64
+      #elif LANGULUS_SIMD(AVX)
+         #define LANGULUS_ALIGNMENT 32
+      #else
+         #define LANGULUS_ALIGNMENT 16
+      #endif
    #endif
    
    /// The default alignment, depends on configuration and enabled SIMD       
    constexpr Offset Alignment = LANGULUS_ALIGNMENT;
    #define LANGULUS_ALIGNED() alignas(::Langulus::Alignment)
 
+   static_assert(::std::has_single_bit(Alignment),
+      "LANGULUS_ALIGNMENT must be a power-of-two");
+   // Translation units may be built for wider registers than the       
+   // alignment - their full-width loads are just unaligned, so only    
+   // make sure SSE2/NEON loads never are                               
+   static_assert(Alignment >= 16,
+      "LANGULUS_ALIGNMENT must be at least 16 bytes");
+   #if (LANGULUS_SIMD(AVX512) and LANGULUS_ALIGNMENT < 64) \
+    or (LANGULUS_SIMD(AVX) and LANGULUS_ALIGNMENT < 32)
+      #pragma message("LANGULUS_ALIGNMENT is smaller than the SIMD registers, that this code is built for - full-width loads will be unaligned")
+   #endif
+
+   #ifndef LANGULUS_CACHE_LINE
+      #define LANGULUS_CACHE_LINE 64
+   #endif
+
+   /// The size of a cache line - data that is written by different threads   
+   /// should be at least that far apart, to avoid false sharing              
+   constexpr Offset CacheLine = LANGULUS_CACHE_LINE;
+
    /// The bitness                                                            
    constexpr Offset Bitness = LANGULUS(BITNESS);
 
@@ -657,6 +692,43 @@ namespace Langulus
                static_assert(false, "Shouldn't be possible");
          }
 
+         /// Check if T is plain-old-data, that can be copied and compared    
+         /// bytewise - either a scalar, or a type that explicitly declares   
+         /// `static constexpr bool CTTI_POD = true;`                         
+         ///   @attention this is the minimal Core counterpart of the RTTI    
+         ///      CT::POD concept, it doesn't rely on any reflection          
+         template<class T>
+         concept POD = Complete<Decvq<Deref<T>>> and (
+               ::std::is_scalar_v<Deref<T>>
+            or requires { requires Decvq<Deref<T>>::CTTI_POD; }
+         );
+
+         /// Check if T can be default-constructed by zeroing its memory -    
+         /// either a scalar, or a type that explicitly declares              
+         /// `static constexpr bool CTTI_Nullifiable = true;`                 
+         ///   @attention this is the minimal Core counterpart of the RTTI    
+         ///      CT::Nullifiable concept, it doesn't rely on any reflection  
+         template<class T>
+         concept Nullifiable = Complete<Decvq<Deref<T>>> and (
+               ::std::is_scalar_v<Deref<T>>
+            or requires { requires Decvq<Deref<T>>::CTTI_Nullifiable; }
+         );
+
+         /// Check if T can be compared bytewise, with the same result as == - 
+         /// either an integer, enum or pointer, a POD type without ==, or a  
+         /// type that explicitly declares                                    
+         /// `static constexpr bool CTTI_BytewiseComparable = true;`          
+         /// Reals never are, because -0 equals 0, and NaN equals nothing     
+         template<class T>
+         concept BytewiseComparable = POD<T> and (
+               ::std::is_integral_v<Decvq<Deref<T>>>
+            or ::std::is_enum_v<Decvq<Deref<T>>>
+            or ::std::is_pointer_v<Decvq<Deref<T>>>
+            or ::std::is_null_pointer_v<Decvq<Deref<T>>>
+            or not Comparable<Decvq<Deref<T>>, Decvq<Deref<T>>>
+            or requires { requires Decvq<Deref<T>>::CTTI_BytewiseComparable; }
+         );
+
       } // namespace Langulus::CT::Inner
 
    } // namespace Langulus::CT
@@ -48,6 +48,19 @@
    #define IF_NOT_LANGULUS_TESTING(a)     a
 #endif
 
+/// Exceptions can be disabled, either explicitly, or by the compiler         
+/// Langulus::Throw will call a handler instead, see SetThrowHandler          
+#if defined(LANGULUS_NO_EXCEPTIONS) or not (defined(__cpp_exceptions) or defined(_CPPUNWIND))
+   #undef LANGULUS_NO_EXCEPTIONS
+   #define LANGULUS_EXCEPTIONS() 0
+   #define IF_LANGULUS_EXCEPTIONS(a)      LANGULUS(NOOP)
+   #define IF_NOT_LANGULUS_EXCEPTIONS(a)  a
+#else
+   #define LANGULUS_EXCEPTIONS() 1
+   #define IF_LANGULUS_EXCEPTIONS(a)      a
+   #define IF_NOT_LANGULUS_EXCEPTIONS(a)  LANGULUS(NOOP)
+#endif
+
 /// Benchmarking                                                              
 /// Tests will become radically slower                                        
 #ifdef LANGULUS_BENCHMARK
@@ -195,6 +208,55 @@
    #error Unknown pointer size
 #endif
 
+#define LANGULUS_ARCH(a) LANGULUS_ARCH_##a()
+
+#if defined(__x86_64__) or defined(_M_X64) or defined(__i386__) or defined(_M_IX86)
+   #define LANGULUS_ARCH_X86() 1
+#else
+   #define LANGULUS_ARCH_X86() 0
+#endif
+
+#if defined(__aarch64__) or defined(_M_ARM64) or defined(__arm__) or defined(_M_ARM)
+   #define LANGULUS_ARCH_ARM() 1
+#else
+   #define LANGULUS_ARCH_ARM() 0
+#endif
+
+/// Detect SIMD instruction sets, that are enabled at compile-time            
+/// These only reflect the flags the code is built with, like -mavx2,         
+/// -march=native, /arch:AVX2, etc.                                           
+#define LANGULUS_SIMD(a) LANGULUS_SIMD_##a()
+
+#if defined(__SSE2__) or defined(_M_X64) or (defined(_M_IX86_FP) and _M_IX86_FP >= 2)
+   #define LANGULUS_SIMD_SSE2() 1
+#else
+   #define LANGULUS_SIMD_SSE2() 0
+#endif
+
+#if defined(__AVX__)
+   #define LANGULUS_SIMD_AVX() 1
+#else
+   #define LANGULUS_SIMD_AVX() 0
+#endif
+
+#if defined(__AVX2__)
+   #define LANGULUS_SIMD_AVX2() 1
+#else
+   #define LANGULUS_SIMD_AVX2() 0
+#endif
+
+#if defined(__AVX512F__) and defined(__AVX512BW__)
+   #define LANGULUS_SIMD_AVX512() 1
+#else
+   #define LANGULUS_SIMD_AVX512() 0
+#endif
+
+#if defined(__ARM_NEON) or defined(__ARM_NEON__) or defined(_M_ARM64)
+   #define LANGULUS_SIMD_NEON() 1
+#else
+   #define LANGULUS_SIMD_NEON() 0
+#endif
+
 /// Detect compiler                                                           
 #if defined(__GNUC__) and not defined(__clang__)
    // We're on a GNUC Compiler!                                         
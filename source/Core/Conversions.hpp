@@ -0,0 +1,989 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Utilities.hpp"
+#include "PowersOfFive.hpp"
+#include <charconv>
+#include <cfloat>
+
+
+namespace Langulus
+{
+
+   namespace CT
+   {
+      /// Check if all T are reals in IEEE-754 binary32 or binary64 format,   
+      /// which are the ones that ToChars and FromChars support               
+      template<class...T>
+      concept ConvertibleReal = sizeof...(T) > 0 and ((BuiltinReal<T>
+          and ::std::numeric_limits<Deref<T>>::is_iec559
+          and (sizeof(Deref<T>) == 4 or sizeof(Deref<T>) == 8)
+         ) and ...);
+   }
+
+   /// Maximum number of letters ToChars can produce for a given number type  
+   /// Reals take the most letters in scientific notation, like               
+   /// -2.2250738585072014e-308                                               
+   template<class T> requires CT::BuiltinInteger<T> or CT::ConvertibleReal<T>
+   constexpr Count MaxCharsOf = CT::BuiltinInteger<T>
+      ? ::std::numeric_limits<T>::digits10 + 1 + (CT::Signed<T> ? 1 : 0)
+      : 1 + ::std::numeric_limits<T>::max_digits10 + 1 + 2 + (sizeof(T) == 4 ? 2 : 3);
+
+   namespace Inner
+   {
+
+      /// All two-digit pairs, so that digits are emitted two at a time       
+      constexpr char DigitPairs[201] =
+         "00010203040506070809"
+         "10111213141516171819"
+         "20212223242526272829"
+         "30313233343536373839"
+         "40414243444546474849"
+         "50515253545556575859"
+         "60616263646566676869"
+         "70717273747576777879"
+         "80818283848586878889"
+         "90919293949596979899";
+
+      /// Write an unsigned integer with a known number of digits             
+      ///   @param out - where to write, must have room for 'digits' letters  
+      ///   @param value - the value to write                                 
+      ///   @param digits - the number of digits in the value, see DigitsOf   
+      LANGULUS(INLINED)
+      constexpr void WriteDigits(Letter* out, ::std::uint64_t value, Count digits) noexcept {
+         auto p = out + digits;
+         while (value >= 100) {
+            const auto pair = (value % 100) * 2;
+            value /= 100;
+            *--p = DigitPairs[pair + 1];
+            *--p = DigitPairs[pair];
+         }
+
+         if (value >= 10) {
+            *--p = DigitPairs[value * 2 + 1];
+            *--p = DigitPairs[value * 2];
+         }
+         else *--p = static_cast<Letter>('0' + value);
+      }
+
+      /// Load eight letters as a little-endian word                          
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr ::std::uint64_t LoadEightLetters(const Letter* p) noexcept {
+         IF_CONSTEXPR() {
+            ::std::uint64_t result = 0;
+            for (int i = 0; i < 8; ++i)
+               result |= static_cast<::std::uint64_t>(static_cast<unsigned char>(p[i])) << (i * 8);
+            return result;
+         }
+         else {
+            ::std::uint64_t result;
+            ::std::memcpy(&result, p, 8);
+            if constexpr (BigEndianMachine)
+               result = ::std::byteswap(result);
+            return result;
+         }
+      }
+
+      /// Check if all eight letters in a word are decimal digits (SWAR)      
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr bool AreEightDigits(const ::std::uint64_t word) noexcept {
+         return ((word & 0xF0F0F0F0F0F0F0F0ull)
+              | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))
+              == 0x3333333333333333ull;
+      }
+
+      /// Convert eight digit letters to their value (SWAR)                   
+      /// The first letter in memory is the most significant digit            
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr ::std::uint64_t ParseEightDigits(::std::uint64_t word) noexcept {
+         word -= 0x3030303030303030ull;
+         word = (word * 10 + (word >> 8)) & 0x00FF00FF00FF00FFull;
+         word = (word * 100 + (word >> 16)) & 0x0000FFFF0000FFFFull;
+         word = (word * 10000 + (word >> 32)) & 0x00000000FFFFFFFFull;
+         return word;
+      }
+
+   } // namespace Langulus::Inner
+
+
+   /// Write an integer as decimal text, without any bounds checking          
+   ///   @param out - where to write, must have room for MaxCharsOf<T>        
+   ///   @param value - the value to write                                    
+   ///   @return the pointer after the last written letter                    
+   template<CT::BuiltinInteger T> LANGULUS(INLINED)
+   constexpr Letter* ToChars(Letter* out, const T value) noexcept {
+      using U = ::std::make_unsigned_t<T>;
+      ::std::uint64_t u;
+      if constexpr (CT::Signed<T>) {
+         if (value < 0) {
+            *out++ = '-';
+            u = static_cast<U>(U(0) - static_cast<U>(value));
+         }
+         else u = static_cast<U>(value);
+      }
+      else u = value;
+
+      const auto digits = DigitsOf(u);
+      Inner::WriteDigits(out, u, digits);
+      return out + digits;
+   }
+
+   /// Write an integer as decimal text, same as ::std::to_chars, but         
+   /// constexpr, with branchless digit counting and two-digit emission       
+   ///   @param first - where to start writing                                
+   ///   @param last - the end of the available buffer                        
+   ///   @param value - the value to write                                    
+   ///   @return the pointer after the last written letter, and an error of   
+   ///      ::std::errc::value_too_large if the value didn't fit              
+   template<CT::BuiltinInteger T> NOD() LANGULUS(INLINED)
+   constexpr ::std::to_chars_result ToChars(Letter* first, Letter* last, const T value) noexcept {
+      const auto needed = DigitsOf(value)
+         + (CT::Signed<T> and value < 0 ? 1 : 0);
+      if (last - first < static_cast<::std::ptrdiff_t>(needed))
+         return {last, ::std::errc::value_too_large};
+      return {ToChars(first, value), ::std::errc {}};
+   }
+
+   /// Parse an integer from decimal text, same as ::std::from_chars, but     
+   /// constexpr, and consuming eight digits at a time via SWAR               
+   /// Accepts an optional '-' for signed types, followed by digits; no       
+   /// whitespace, no '+', no base prefixes                                   
+   ///   @param first - the first letter                                      
+   ///   @param last - the end of the text                                    
+   ///   @param value - [out] the parsed value, untouched on error            
+   ///   @return the pointer after the last consumed letter, and an error of  
+   ///      ::std::errc::invalid_argument if there are no digits, or          
+   ///      ::std::errc::result_out_of_range if the value doesn't fit in T    
+   template<CT::BuiltinInteger T> LANGULUS(INLINED)
+   constexpr ::std::from_chars_result FromChars(const Letter* first, const Letter* last, T& value) noexcept {
+      using U = ::std::make_unsigned_t<T>;
+      auto p = first;
+      bool negative = false;
+      if constexpr (CT::Signed<T>) {
+         if (p != last and *p == '-') {
+            negative = true;
+            ++p;
+         }
+      }
+
+      // Leading zeroes don't contribute to overflow                    
+      const auto digitsBegin = p;
+      while (p != last and *p == '0')
+         ++p;
+      const auto significant = p;
+
+      // Up to 19 digits always fit in 64 bits, so consume them fast    
+      ::std::uint64_t u = 0;
+      while (last - p >= 8 and p - significant <= 11) {
+         const auto word = Inner::LoadEightLetters(p);
+         if (not Inner::AreEightDigits(word))
+            break;
+         u = u * 100'000'000 + Inner::ParseEightDigits(word);
+         p += 8;
+      }
+
+      bool overflow = false;
+      while (p != last and IsDigit(*p)) {
+         const auto digit = static_cast<::std::uint64_t>(*p - '0');
+         if (p - significant >= 19) {
+            // From here on, each digit might overflow                  
+            if (u > (::std::numeric_limits<::std::uint64_t>::max() - digit) / 10)
+               overflow = true;
+         }
+         if (not overflow)
+            u = u * 10 + digit;
+         ++p;
+      }
+
+      if (p == digitsBegin)
+         return {first, ::std::errc::invalid_argument};
+
+      // Check if the magnitude fits in T                               
+      if constexpr (CT::Signed<T>) {
+         constexpr auto max = static_cast<::std::uint64_t>(::std::numeric_limits<T>::max());
+         if (overflow or u > max + (negative ? 1 : 0))
+            return {p, ::std::errc::result_out_of_range};
+         value = negative ? static_cast<T>(U(0) - static_cast<U>(u))
+                          : static_cast<T>(u);
+      }
+      else {
+         if (overflow or u > ::std::numeric_limits<T>::max())
+            return {p, ::std::errc::result_out_of_range};
+         value = static_cast<T>(u);
+      }
+      return {p, ::std::errc {}};
+   }
+
+   /// Parse an integer from a token, see FromChars(first, last, value)       
+   ///   @param text - the text to parse                                      
+   ///   @param value - [out] the parsed value, untouched on error            
+   ///   @return the parse result                                             
+   template<CT::BuiltinInteger T> LANGULUS(INLINED)
+   constexpr ::std::from_chars_result FromChars(const Token& text, T& value) noexcept {
+      return FromChars(text.data(), text.data() + text.size(), value);
+   }
+
+
+   namespace Inner
+   {
+
+      /// IEEE-754 layout of a real number, along with the constants used by  
+      /// the shortest formatter and the fast parser                          
+      template<CT::ConvertibleReal T>
+      struct RealLayout {
+         using Bits = Conditional<sizeof(T) == 4, ::std::uint32_t, ::std::uint64_t>;
+
+         static constexpr int MantissaBits = ::std::numeric_limits<T>::digits - 1;
+         static constexpr int ExponentBits = sizeof(T) * 8 - 1 - MantissaBits;
+         static constexpr int InfiniteExponent = (1 << ExponentBits) - 1;
+         static constexpr int Bias = InfiniteExponent >> 1;
+         // Binary exponent of subnormals                               
+         static constexpr int MinExponent = 1 - Bias - MantissaBits;
+         // Decimal exponents, beyond which parsing gives zero/infinity 
+         static constexpr int SmallestPowerOfTen = sizeof(T) == 4 ? -64 : -342;
+         static constexpr int LargestPowerOfTen = sizeof(T) == 4 ? 38 : 308;
+         // Decimal exponents, where exact halfway cases can occur      
+         static constexpr int MinRoundToEven = sizeof(T) == 4 ? -17 : -4;
+         static constexpr int MaxRoundToEven = sizeof(T) == 4 ? 10 : 23;
+         // Limits of exact parsing via a single multiplication         
+         static constexpr int MaxExactPowerOfTen = sizeof(T) == 4 ? 10 : 22;
+         static constexpr ::std::uint64_t MaxExactMantissa = 1ull << (MantissaBits + 1);
+      };
+
+      /// Powers of ten, that are exactly representable by a Double           
+      constexpr Double ExactPowersOfTen[23] {
+         1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+
+      /// floor(e * log10(2)), exact for |e| <= 5456721                       
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr int FloorLog10Pow2(const int e) noexcept {
+         return static_cast<int>((e * 661'971'961'083ll) >> 41);
+      }
+
+      /// floor(log10(3/4 * 2^e)), exact for |e| <= 5456721                   
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr int FloorLog10ThreeQuartersPow2(const int e) noexcept {
+         return static_cast<int>((e * 661'971'961'083ll - 274'743'187'321ll) >> 41);
+      }
+
+      /// floor(e * log2(10)), exact for |e| <= 1838394                       
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr int FloorLog2Pow10(const int e) noexcept {
+         return static_cast<int>((e * 913'124'641'741ll) >> 38);
+      }
+
+      /// A decimal real number, equal to mDigits * 10^mExponent              
+      struct DecimalReal {
+         ::std::uint64_t mDigits;
+         int mExponent;
+      };
+
+      /// Get 10^-k, scaled into [2^127, 2^128) (or into [2^63, 2^64) for     
+      /// binary32), and rounded up, as required by the Schubfach algorithm   
+      ///   @param k - the decimal exponent                                   
+      ///   @return the approximation of 10^-k                                
+      template<CT::ConvertibleReal T> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr PowerOfFive InversePowerOfTen(const int k) noexcept {
+         auto g = PowersOfFive[-k - SmallestPowerOfFive];
+         if constexpr (sizeof(T) == 4)
+            ++g.mHigh;
+         else {
+            ++g.mLow;
+            g.mHigh += g.mLow == 0;
+         }
+         return g;
+      }
+
+      /// Multiply by a power of ten, and round the upper bits to odd         
+      /// Since the power of ten is rounded up, the discarded bits can't be   
+      /// exactly zero - instead, anything up to one in the first discarded   
+      /// word counts as zero, which lets exact ties through                  
+      ///   @param g - the power of ten, see InversePowerOfTen                
+      ///   @param cp - the scaled significand                                
+      ///   @return the upper bits of the product, with the lowest bit set    
+      ///           if any of the discarded bits are set                      
+      template<CT::ConvertibleReal T> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr ::std::uint64_t RoundToOdd(const PowerOfFive& g, const ::std::uint64_t cp) noexcept {
+         if constexpr (sizeof(T) == 4) {
+            // The significand is shifted by 32 more bits, to make room 
+            // for a discarded word                                     
+            ::std::uint64_t high;
+            (void) MultiplyWide(g.mHigh, cp, high);
+            return (high >> 32) | ((high & 0xFFFFFFFF) > 1);
+         }
+         else {
+            ::std::uint64_t x1, y1;
+            (void) MultiplyWide(g.mLow, cp, x1);
+            const auto y0 = MultiplyWide(g.mHigh, cp, y1);
+            const auto middle = y0 + x1;
+            return (y1 + (middle < y0)) | (middle > 1);
+         }
+      }
+
+      /// Find the shortest decimal that rounds back to a finite nonzero real 
+      /// Implements Raffaello Giulietti's Schubfach algorithm - among all    
+      /// shortest decimals in the rounding interval, picks the closest one,  
+      /// and resolves ties to even, just like ::std::to_chars                
+      ///   @param mantissa - the stored mantissa bits                        
+      ///   @param exponent - the stored (biased) exponent bits               
+      ///   @return the decimal, possibly with trailing zeroes in its digits  
+      template<CT::ConvertibleReal T> NOD() LANGULUS(INLINED)
+      constexpr DecimalReal Schubfach(const ::std::uint64_t mantissa, const int exponent) noexcept {
+         using L = RealLayout<T>;
+         ::std::uint64_t c;
+         int q;
+
+         if (exponent) {
+            c = mantissa | (1ull << L::MantissaBits);
+            q = exponent - L::Bias - L::MantissaBits;
+
+            // Small integers are their own shortest representation     
+            if (q < 0 and q >= -L::MantissaBits) {
+               const auto f = c >> -q;
+               if ((f << -q) == c)
+                  return {f, 0};
+            }
+         }
+         else {
+            c = mantissa;
+            q = L::MinExponent;
+         }
+
+         // The rounding interval is closed only for even significands  
+         const ::std::uint64_t out = c & 1;
+         const ::std::uint64_t cb = c << 2;
+         const ::std::uint64_t cbr = cb + 2;
+         ::std::uint64_t cbl;
+         int k;
+         if (c != (1ull << L::MantissaBits) or q == L::MinExponent) {
+            cbl = cb - 2;
+            k = FloorLog10Pow2(q);
+         }
+         else {
+            // The lower neighbour is closer for powers of two          
+            cbl = cb - 1;
+            k = FloorLog10ThreeQuartersPow2(q);
+         }
+
+         const int h = q + FloorLog2Pow10(-k) + 1 + (sizeof(T) == 4 ? 32 : 0);
+         const auto g = InversePowerOfTen<T>(k);
+         const auto vb  = RoundToOdd<T>(g, cb  << h);
+         const auto vbl = RoundToOdd<T>(g, cbl << h);
+         const auto vbr = RoundToOdd<T>(g, cbr << h);
+
+         // Try a decimal with one digit less first                     
+         const auto s = vb >> 2;
+         if (s >= 10) {
+            const auto sp10 = s / 10 * 10;
+            const auto tp10 = sp10 + 10;
+            const bool upin = vbl + out <= sp10 << 2;
+            const bool wpin = (tp10 << 2) + out <= vbr;
+            if (upin != wpin)
+               return {upin ? sp10 : tp10, k};
+         }
+
+         // Then pick the closest one of the two neighbours             
+         const auto t = s + 1;
+         const bool uin = vbl + out <= s << 2;
+         const bool win = (t << 2) + out <= vbr;
+         if (uin != win)
+            return {uin ? s : t, k};
+
+         const auto middle = (s + t) << 1;
+         return {vb < middle or (vb == middle and (s & 1) == 0) ? s : t, k};
+      }
+
+      /// Find the shortest decimal that rounds back to a finite nonzero real 
+      ///   @param mantissa - the stored mantissa bits                        
+      ///   @param exponent - the stored (biased) exponent bits               
+      ///   @return the decimal, with no trailing zeroes in its digits        
+      template<CT::ConvertibleReal T> NOD() LANGULUS(INLINED)
+      constexpr DecimalReal ShortestDecimal(const ::std::uint64_t mantissa, const int exponent) noexcept {
+         auto result = Schubfach<T>(mantissa, exponent);
+         while (result.mDigits % 10 == 0) {
+            result.mDigits /= 10;
+            ++result.mExponent;
+         }
+         return result;
+      }
+
+      /// Write the exact value of an integral real, c * 2^q                  
+      ///   @param out - where to write                                       
+      ///   @param c - the significand                                        
+      ///   @param q - the binary exponent, must be in the range [0, 40]      
+      ///   @return the pointer after the last written letter                 
+      LANGULUS(INLINED)
+      constexpr Letter* WriteExactInteger(Letter* out, const ::std::uint64_t c, const int q) noexcept {
+         // At most 96 bits, so divide in 32-bit limbs                  
+         ::std::uint32_t limbs[3] {};
+         const auto low = c << q;
+         const auto high = q ? c >> (64 - q) : 0;
+         limbs[0] = static_cast<::std::uint32_t>(low);
+         limbs[1] = static_cast<::std::uint32_t>(low >> 32);
+         limbs[2] = static_cast<::std::uint32_t>(high);
+
+         ::std::uint32_t chunks[4] {};
+         int count = 0;
+         do {
+            ::std::uint64_t remainder = 0;
+            for (int i = 2; i >= 0; --i) {
+               const auto part = (remainder << 32) | limbs[i];
+               limbs[i] = static_cast<::std::uint32_t>(part / 1'000'000'000);
+               remainder = part % 1'000'000'000;
+            }
+            chunks[count++] = static_cast<::std::uint32_t>(remainder);
+         } while (limbs[0] or limbs[1] or limbs[2]);
+
+         // The most significant chunk is unpadded, the rest have 9 digits
+         const auto digits = DigitsOf(chunks[count - 1]);
+         WriteDigits(out, chunks[count - 1], digits);
+         out += digits;
+         for (int i = count - 2; i >= 0; --i) {
+            for (int j = 0; j < 9; ++j)
+               out[j] = '0';
+            const auto chunkDigits = DigitsOf(chunks[i]);
+            WriteDigits(out + 9 - chunkDigits, chunks[i], chunkDigits);
+            out += 9;
+         }
+         return out;
+      }
+
+      /// Write a decimal real in fixed or scientific notation, whichever is  
+      /// shorter, preferring fixed on a tie - same as ::std::to_chars        
+      ///   @param out - where to write, must have room for MaxCharsOf<Double>
+      ///   @param decimal - the decimal to write                             
+      ///   @param c - the binary significand of the real                     
+      ///   @param q - the binary exponent of the real                        
+      ///   @return the pointer after the last written letter                 
+      LANGULUS(INLINED)
+      constexpr Letter* WriteDecimal(Letter* out, const DecimalReal& decimal, const ::std::uint64_t c, const int q) noexcept {
+         const auto n = static_cast<int>(DigitsOf(decimal.mDigits));
+         const auto e = decimal.mExponent;
+         const auto scientific = e + n - 1;
+         const auto scientificAbs = scientific < 0 ? -scientific : scientific;
+         const auto scientificLength = n + (n > 1) + 2 + (scientificAbs >= 100 ? 3 : 2);
+         const auto fixedLength = e >= 0 ? n + e
+                                : n + e > 0 ? n + 1 : 2 - e;
+
+         if (fixedLength <= scientificLength) {
+            if (e > 0 and q > 0) {
+               // Integer, that might not fit in a significand - the    
+               // digits must be exact, instead of padded with zeroes   
+               out = WriteExactInteger(out, c, q);
+            }
+            else if (e >= 0) {
+               // Integer, padded with zeroes                           
+               WriteDigits(out, decimal.mDigits, n);
+               out += n;
+               for (int i = 0; i < e; ++i)
+                  *out++ = '0';
+            }
+            else if (n + e > 0) {
+               // Dot somewhere between the digits                      
+               WriteDigits(out, decimal.mDigits, n);
+               for (int i = n; i > n + e; --i)
+                  out[i] = out[i - 1];
+               out[n + e] = '.';
+               out += n + 1;
+            }
+            else {
+               // Dot, followed by zeroes, before all digits            
+               *out++ = '0';
+               *out++ = '.';
+               for (int i = 0; i < -(n + e); ++i)
+                  *out++ = '0';
+               WriteDigits(out, decimal.mDigits, n);
+               out += n;
+            }
+            return out;
+         }
+
+         // Scientific notation, with at least two exponent digits      
+         WriteDigits(out + 1, decimal.mDigits, n);
+         out[0] = out[1];
+         if (n > 1) {
+            out[1] = '.';
+            out += n + 1;
+         }
+         else ++out;
+
+         *out++ = 'e';
+         *out++ = scientific < 0 ? '-' : '+';
+         if (scientificAbs < 10)
+            *out++ = '0';
+         const auto exponentDigits = DigitsOf(scientificAbs);
+         WriteDigits(out, static_cast<::std::uint64_t>(scientificAbs), exponentDigits);
+         return out + exponentDigits;
+      }
+
+      /// A real being assembled: its mantissa bits and its biased exponent   
+      struct AdjustedMantissa {
+         ::std::uint64_t mMantissa;
+         int mPower2;
+
+         constexpr bool operator == (const AdjustedMantissa&) const noexcept = default;
+      };
+
+      /// Convert w * 10^q to the nearest real, ties to even                  
+      /// Implements the Eisel-Lemire algorithm, which is exact as long as w  
+      /// contains all the significant digits                                 
+      ///   @param q - the decimal exponent                                   
+      ///   @param w - the decimal significand                                
+      ///   @return the real, can be zero or infinity                         
+      template<CT::ConvertibleReal T> NOD() LANGULUS(INLINED)
+      constexpr AdjustedMantissa EiselLemire(const ::std::int64_t q, ::std::uint64_t w) noexcept {
+         using L = RealLayout<T>;
+         if (w == 0 or q < L::SmallestPowerOfTen)
+            return {0, 0};
+         if (q > L::LargestPowerOfTen)
+            return {0, L::InfiniteExponent};
+
+         // Between 5^-27 and 5^-1 the table must be rounded up         
+         auto power = PowersOfFive[q - SmallestPowerOfFive];
+         if (q < 0 and q >= -27) {
+            ++power.mLow;
+            power.mHigh += power.mLow == 0;
+         }
+
+         const int lz = CountLeadingZeroes(w);
+         w <<= lz;
+
+         // The upper 64 bits of the product are enough, unless they're 
+         // all ones below the bits of interest                         
+         ::std::uint64_t high;
+         auto low = MultiplyWide(w, power.mHigh, high);
+         constexpr auto precisionMask = ~0ull >> (L::MantissaBits + 3);
+         if ((high & precisionMask) == precisionMask) {
+            ::std::uint64_t secondHigh;
+            (void) MultiplyWide(w, power.mLow, secondHigh);
+            low += secondHigh;
+            high += secondHigh > low;
+         }
+
+         const int upperBit = static_cast<int>(high >> 63);
+         const int shift = upperBit + 64 - L::MantissaBits - 3;
+         AdjustedMantissa result {
+            high >> shift,
+            FloorLog2Pow10(static_cast<int>(q)) + 63 + upperBit - lz + L::Bias
+         };
+
+         if (result.mPower2 <= 0) {
+            // Subnormal, or zero                                       
+            if (-result.mPower2 + 1 >= 64)
+               return {0, 0};
+            result.mMantissa >>= -result.mPower2 + 1;
+            result.mMantissa += result.mMantissa & 1;
+            result.mMantissa >>= 1;
+            result.mPower2 = result.mMantissa < (1ull << L::MantissaBits) ? 0 : 1;
+            return result;
+         }
+
+         // Exactly halfway between two reals, so round to even         
+         if (low <= 1 and q >= L::MinRoundToEven and q <= L::MaxRoundToEven
+         and (result.mMantissa & 3) == 1 and (result.mMantissa << shift) == high)
+            result.mMantissa &= ~1ull;
+
+         result.mMantissa += result.mMantissa & 1;
+         result.mMantissa >>= 1;
+         if (result.mMantissa >= (2ull << L::MantissaBits)) {
+            result.mMantissa = 1ull << L::MantissaBits;
+            ++result.mPower2;
+         }
+
+         result.mMantissa &= ~(1ull << L::MantissaBits);
+         if (result.mPower2 >= L::InfiniteExponent)
+            return {0, L::InfiniteExponent};
+         return result;
+      }
+
+      /// Any real is exactly halfway between two neighbours with no more     
+      /// than 767 significant digits, so further digits only break ties      
+      constexpr int BigDigits = 800;
+
+      /// A fixed capacity unsigned big integer, just enough for deciding the 
+      /// rounding of any decimal with up to BigDigits significant digits     
+      struct BigUnsigned {
+         static constexpr int Capacity = 112;
+         ::std::uint32_t mLimbs[Capacity] {};
+         int mCount = 0;
+
+         constexpr BigUnsigned(const ::std::uint64_t value = 0) noexcept {
+            mLimbs[0] = static_cast<::std::uint32_t>(value);
+            mLimbs[1] = static_cast<::std::uint32_t>(value >> 32);
+            mCount = mLimbs[1] ? 2 : mLimbs[0] ? 1 : 0;
+         }
+
+         /// Multiply by a factor, and add an addend                          
+         constexpr void MultiplyAdd(const ::std::uint32_t factor, const ::std::uint32_t addend) noexcept {
+            ::std::uint64_t carry = addend;
+            for (int i = 0; i < mCount; ++i) {
+               carry += static_cast<::std::uint64_t>(mLimbs[i]) * factor;
+               mLimbs[i] = static_cast<::std::uint32_t>(carry);
+               carry >>= 32;
+            }
+            if (carry and mCount < Capacity)
+               mLimbs[mCount++] = static_cast<::std::uint32_t>(carry);
+         }
+
+         /// Multiply by 5^n                                                  
+         constexpr void MultiplyPow5(int n) noexcept {
+            for (; n >= 13; n -= 13)
+               MultiplyAdd(1'220'703'125u, 0);
+            if (n > 0)
+               MultiplyAdd(static_cast<::std::uint32_t>(PowersOfTen[n] >> n), 0);
+         }
+
+         /// Multiply by 2^n                                                  
+         constexpr void ShiftLeft(const int n) noexcept {
+            if (mCount == 0 or n <= 0)
+               return;
+
+            const int limbs = n / 32;
+            const int bits = n % 32;
+            const int count = mCount + limbs + 1 > Capacity
+               ? Capacity - limbs - 1 : mCount;
+            mLimbs[count + limbs] = 0;
+            for (int i = count - 1; i >= 0; --i) {
+               const auto limb = static_cast<::std::uint64_t>(mLimbs[i]) << bits;
+               mLimbs[i + limbs + 1] |= static_cast<::std::uint32_t>(limb >> 32);
+               mLimbs[i + limbs] = static_cast<::std::uint32_t>(limb);
+            }
+            for (int i = 0; i < limbs; ++i)
+               mLimbs[i] = 0;
+
+            mCount = count + limbs + 1;
+            while (mCount and mLimbs[mCount - 1] == 0)
+               --mCount;
+         }
+
+         /// Three-way comparison                                             
+         constexpr int Compare(const BigUnsigned& rhs) const noexcept {
+            if (mCount != rhs.mCount)
+               return mCount < rhs.mCount ? -1 : 1;
+            for (int i = mCount - 1; i >= 0; --i) {
+               if (mLimbs[i] != rhs.mLimbs[i])
+                  return mLimbs[i] < rhs.mLimbs[i] ? -1 : 1;
+            }
+            return 0;
+         }
+      };
+
+      /// The digits of a decimal real, as they appear in text                
+      struct DecimalText {
+         const Letter* mIntegerBegin;
+         const Letter* mIntegerEnd;
+         const Letter* mFractionBegin;
+         const Letter* mFractionEnd;
+         ::std::int64_t mExponent;
+      };
+
+      /// Decide the rounding of a decimal with too many digits, when the     
+      /// Eisel-Lemire algorithm can't, by comparing it against the halfway   
+      /// point between the two candidates exactly                            
+      ///   @param text - the digits                                          
+      ///   @param lower - the lower candidate                                
+      ///   @return the correctly rounded real                                
+      template<CT::ConvertibleReal T> NOD() LANGULUS(NOINLINE)
+      constexpr AdjustedMantissa DigitCompare(const DecimalText& text, AdjustedMantissa lower) noexcept {
+         using L = RealLayout<T>;
+
+         // Gather up to BigDigits significant digits, nine at a time   
+         BigUnsigned digits;
+         ::std::int64_t exponent = text.mExponent;
+         bool tail = false;
+         int count = 0;
+         ::std::uint32_t chunk = 0;
+         int chunkDigits = 0;
+         const auto gather = [&](const Letter* from, const Letter* to) {
+            for (auto p = from; p != to; ++p) {
+               if (count == 0 and *p == '0') {
+                  // Leading zeroes                                     
+                  continue;
+               }
+
+               if (count == BigDigits) {
+                  // Dropped digits only shift the exponent             
+                  tail |= *p != '0';
+                  ++exponent;
+                  continue;
+               }
+
+               chunk = chunk * 10 + static_cast<::std::uint32_t>(*p - '0');
+               ++count;
+               if (++chunkDigits == 9) {
+                  digits.MultiplyAdd(1'000'000'000u, chunk);
+                  chunk = 0;
+                  chunkDigits = 0;
+               }
+            }
+         };
+
+         gather(text.mIntegerBegin, text.mIntegerEnd);
+         gather(text.mFractionBegin, text.mFractionEnd);
+         if (chunkDigits)
+            digits.MultiplyAdd(static_cast<::std::uint32_t>(PowersOfTen[chunkDigits]), chunk);
+
+         // The halfway point is (2m + 1) * 2^(e - 1)                   
+         ::std::uint64_t m = lower.mMantissa;
+         int e = L::MinExponent;
+         if (lower.mPower2) {
+            m |= 1ull << L::MantissaBits;
+            e = lower.mPower2 - L::Bias - L::MantissaBits;
+         }
+
+         BigUnsigned halfway {2 * m + 1};
+         if (exponent >= 0)
+            digits.MultiplyPow5(static_cast<int>(exponent));
+         else
+            halfway.MultiplyPow5(static_cast<int>(-exponent));
+
+         const auto shift = e - 1 - exponent;
+         if (shift > 0)
+            halfway.ShiftLeft(static_cast<int>(shift));
+         else
+            digits.ShiftLeft(static_cast<int>(-shift));
+
+         const auto order = digits.Compare(halfway);
+         if (order > 0 or (order == 0 and (tail or (m & 1)))) {
+            // Round up, possibly into the next binade, or infinity     
+            if (++lower.mMantissa == (1ull << L::MantissaBits)) {
+               lower.mMantissa = 0;
+               ++lower.mPower2;
+            }
+         }
+         return lower;
+      }
+
+      /// Compare a text with a lowercase word, ignoring case                 
+      NOD() LANGULUS(INLINED)
+      constexpr bool StartsWithNoCase(const Letter* p, const Letter* last, const Token& word) noexcept {
+         if (last - p < static_cast<::std::ptrdiff_t>(word.size()))
+            return false;
+         for (auto c : word) {
+            if ((*p++ | 0x20) != c)
+               return false;
+         }
+         return true;
+      }
+
+   } // namespace Langulus::Inner
+
+
+   /// Write a real as the shortest decimal text that parses back to the      
+   /// exact same value, without any bounds checking                          
+   /// Produces the same text as ::std::to_chars without a format, but is     
+   /// constexpr: fixed or scientific notation, whichever is shorter, and     
+   /// 'inf', '-inf', 'nan' or '-nan' for special values                      
+   ///   @param out - where to write, must have room for MaxCharsOf<T>        
+   ///   @param value - the value to write                                    
+   ///   @return the pointer after the last written letter                    
+   template<CT::ConvertibleReal T> LANGULUS(INLINED)
+   constexpr Letter* ToChars(Letter* out, const T value) noexcept {
+      using L = Inner::RealLayout<T>;
+      using Bits = typename L::Bits;
+      const auto bits = ::std::bit_cast<Bits>(value);
+      const auto mantissa = bits & ((Bits(1) << L::MantissaBits) - 1);
+      const auto exponent = static_cast<int>((bits >> L::MantissaBits) & L::InfiniteExponent);
+      if (bits >> (sizeof(T) * 8 - 1))
+         *out++ = '-';
+
+      if (exponent == L::InfiniteExponent) {
+         const auto special = mantissa ? "nan" : "inf";
+         for (int i = 0; i < 3; ++i)
+            *out++ = special[i];
+         return out;
+      }
+
+      if (exponent == 0 and mantissa == 0) {
+         *out++ = '0';
+         return out;
+      }
+
+      const auto c = exponent ? mantissa | (Bits(1) << L::MantissaBits) : mantissa;
+      const auto q = (exponent ? exponent : 1) - L::Bias - L::MantissaBits;
+      return Inner::WriteDecimal(out, Inner::ShortestDecimal<T>(mantissa, exponent), c, q);
+   }
+
+   /// Write a real as the shortest decimal text that parses back to the      
+   /// exact same value, same as ::std::to_chars, but constexpr               
+   ///   @param first - where to start writing                                
+   ///   @param last - the end of the available buffer                        
+   ///   @param value - the value to write                                    
+   ///   @return the pointer after the last written letter, and an error of   
+   ///      ::std::errc::value_too_large if the text didn't fit               
+   template<CT::ConvertibleReal T> NOD() LANGULUS(INLINED)
+   constexpr ::std::to_chars_result ToChars(Letter* first, Letter* last, const T value) noexcept {
+      Letter buffer[MaxCharsOf<T>] {};
+      const auto length = ToChars(buffer, value) - buffer;
+      if (last - first < length)
+         return {last, ::std::errc::value_too_large};
+      for (::std::ptrdiff_t i = 0; i < length; ++i)
+         first[i] = buffer[i];
+      return {first + length, ::std::errc {}};
+   }
+
+   /// Parse a real from decimal text, same as ::std::from_chars with         
+   /// ::std::chars_format::general, but constexpr                            
+   /// Accepts an optional '-', digits with an optional dot, and an optional  
+   /// exponent, or 'inf', 'infinity', 'nan', 'nan(...)' in any case          
+   /// Rounds to nearest, ties to even. The Eisel-Lemire algorithm settles    
+   /// nearly all inputs; only decimals with more than 19 significant digits  
+   /// that happen to be really close to a halfway point take the slow path   
+   ///   @param first - the first letter                                      
+   ///   @param last - the end of the text                                    
+   ///   @param value - [out] the parsed value, untouched on error            
+   ///   @return the pointer after the last consumed letter, and an error of  
+   ///      ::std::errc::invalid_argument if there are no digits, or          
+   ///      ::std::errc::result_out_of_range if the value overflows to        
+   ///      infinity, or underflows to zero                                   
+   template<CT::ConvertibleReal T> LANGULUS(INLINED)
+   constexpr ::std::from_chars_result FromChars(const Letter* first, const Letter* last, T& value) noexcept {
+      using L = Inner::RealLayout<T>;
+      using Bits = typename L::Bits;
+      constexpr Bits SignBit = Bits(1) << (sizeof(T) * 8 - 1);
+      auto p = first;
+      const bool negative = p != last and *p == '-';
+      if (negative)
+         ++p;
+
+      // Accumulate all digits, wrapping around on overflow             
+      ::std::uint64_t w = 0;
+      Inner::DecimalText text {p, p, p, p, 0};
+      while (p != last and IsDigit(*p))
+         w = w * 10 + static_cast<::std::uint64_t>(*p++ - '0');
+      text.mIntegerEnd = text.mFractionBegin = text.mFractionEnd = p;
+
+      if (p != last and *p == '.') {
+         text.mFractionBegin = ++p;
+         while (last - p >= 8) {
+            const auto word = Inner::LoadEightLetters(p);
+            if (not Inner::AreEightDigits(word))
+               break;
+            w = w * 100'000'000 + Inner::ParseEightDigits(word);
+            p += 8;
+         }
+         while (p != last and IsDigit(*p))
+            w = w * 10 + static_cast<::std::uint64_t>(*p++ - '0');
+         text.mFractionEnd = p;
+      }
+
+      auto digits = (text.mIntegerEnd - text.mIntegerBegin)
+                  + (text.mFractionEnd - text.mFractionBegin);
+      if (digits == 0) {
+         // No digits, so it's either a special value, or an error      
+         p = text.mIntegerBegin;
+         Bits bits;
+         if (Inner::StartsWithNoCase(p, last, "inf")) {
+            p += Inner::StartsWithNoCase(p, last, "infinity") ? 8 : 3;
+            bits = static_cast<Bits>(L::InfiniteExponent) << L::MantissaBits;
+         }
+         else if (Inner::StartsWithNoCase(p, last, "nan")) {
+            p += 3;
+            if (p != last and *p == '(') {
+               auto close = p + 1;
+               while (close != last and (IsAlpha(*close) or IsDigit(*close) or *close == '_'))
+                  ++close;
+               if (close != last and *close == ')')
+                  p = close + 1;
+            }
+            bits = (static_cast<Bits>(L::InfiniteExponent) << L::MantissaBits)
+                 | (Bits(1) << (L::MantissaBits - 1));
+         }
+         else return {first, ::std::errc::invalid_argument};
+
+         value = ::std::bit_cast<T>(negative ? bits | SignBit : bits);
+         return {p, ::std::errc {}};
+      }
+
+      // Optional exponent, ignored if there are no digits after 'e'    
+      text.mExponent = -(text.mFractionEnd - text.mFractionBegin);
+      if (p != last and (*p == 'e' or *p == 'E')) {
+         auto e = p + 1;
+         bool negativeExponent = false;
+         if (e != last and (*e == '-' or *e == '+'))
+            negativeExponent = *e++ == '-';
+
+         if (e != last and IsDigit(*e)) {
+            ::std::int64_t explicitExponent = 0;
+            while (e != last and IsDigit(*e)) {
+               if (explicitExponent < 0x10000000)
+                  explicitExponent = explicitExponent * 10 + (*e - '0');
+               ++e;
+            }
+            text.mExponent += negativeExponent ? -explicitExponent : explicitExponent;
+            p = e;
+         }
+      }
+
+      // Keep only the first 19 significant digits                      
+      auto q = text.mExponent;
+      bool truncated = false;
+      if (digits > 19) {
+         auto s = text.mIntegerBegin;
+         while (s != text.mIntegerEnd and *s == '0')
+            ++s;
+         if (s == text.mIntegerEnd) {
+            digits -= text.mIntegerEnd - text.mIntegerBegin;
+            s = text.mFractionBegin;
+            while (s != text.mFractionEnd and *s == '0')
+               ++s;
+            digits -= s - text.mFractionBegin;
+         }
+         else digits -= s - text.mIntegerBegin;
+
+         if (digits > 19) {
+            truncated = true;
+            w = 0;
+            for (int taken = 0; taken < 19; ++s) {
+               if (s == text.mIntegerEnd)
+                  s = text.mFractionBegin;
+               w = w * 10 + static_cast<::std::uint64_t>(*s - '0');
+               ++taken;
+            }
+            q += digits - 19;
+         }
+      }
+
+      Bits bits;
+      if (not truncated and w <= L::MaxExactMantissa
+      and q >= -L::MaxExactPowerOfTen and q <= L::MaxExactPowerOfTen
+      and (FLT_EVAL_METHOD == 0 or ::std::is_constant_evaluated())) {
+         // Both w and 10^q are exact, so a single rounding is correct  
+         auto result = static_cast<T>(w);
+         const auto power = static_cast<T>(Inner::ExactPowersOfTen[q < 0 ? -q : q]);
+         if (q < 0)
+            result /= power;
+         else
+            result *= power;
+         bits = ::std::bit_cast<Bits>(result);
+      }
+      else {
+         auto am = Inner::EiselLemire<T>(q, w);
+         if (truncated and am != Inner::EiselLemire<T>(q, w + 1))
+            am = Inner::DigitCompare<T>(text, am);
+         if (am.mPower2 == L::InfiniteExponent or (am.mPower2 == 0 and am.mMantissa == 0 and w))
+            return {p, ::std::errc::result_out_of_range};
+         bits = static_cast<Bits>(am.mMantissa | (static_cast<::std::uint64_t>(am.mPower2) << L::MantissaBits));
+      }
+
+      value = ::std::bit_cast<T>(negative ? bits | SignBit : bits);
+      return {p, ::std::errc {}};
+   }
+
+   /// Parse a real from a token, see FromChars(first, last, value)           
+   ///   @param text - the text to parse                                      
+   ///   @param value - [out] the parsed value, untouched on error            
+   ///   @return the parse result                                             
+   template<CT::ConvertibleReal T> LANGULUS(INLINED)
+   constexpr ::std::from_chars_result FromChars(const Token& text, T& value) noexcept {
+      return FromChars(text.data(), text.data() + text.size(), value);
+   }
+
+} // namespace Langulus
@@ -0,0 +1,259 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Multiversion.hpp"
+#include <array>
+
+#if LANGULUS_ARCH(X86)
+   #include <immintrin.h>
+#endif
+
+
+namespace Langulus
+{
+   namespace CT
+   {
+      /// Check if all T are types, that raw memory can be viewed as          
+      template<class...T>
+      concept ByteLike = sizeof...(T) > 0 and ((sizeof(T) == 1
+          and (BuiltinCharacter<T> or SimilarAsOneOf<T, ::std::byte, unsigned char, signed char>)
+         ) and ...);
+   }
+
+   namespace Inner
+   {
+
+      /// Numbers, that can be byteswapped - their size must match one of     
+      /// the unsigned integers                                               
+      template<class T>
+      concept EndianNumber = CT::BuiltinNumber<T>
+         and (sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8);
+
+      /// The unsigned integer of the same size as T                          
+      template<Offset SIZE>
+      using EndianBits = Conditional<SIZE == 1, ::std::uint8_t,
+                         Conditional<SIZE == 2, ::std::uint16_t,
+                         Conditional<SIZE == 4, ::std::uint32_t,
+                                                ::std::uint64_t>>>;
+
+   } // namespace Langulus::Inner
+
+
+   /// Reverse the bytes of a number                                          
+   ///   @param value - the number                                            
+   ///   @return the number with its bytes reversed                           
+   template<Inner::EndianNumber T> NOD() LANGULUS(INLINED)
+   constexpr T ByteSwap(const T value) noexcept {
+      using U = Inner::EndianBits<sizeof(T)>;
+      if constexpr (sizeof(T) == 1)
+         return value;
+      else
+         return ::std::bit_cast<T>(::std::byteswap(::std::bit_cast<U>(value)));
+   }
+
+   /// Read a little-endian number from memory, that may be unaligned         
+   /// Done byte by byte at compile-time, and via memcpy at runtime           
+   ///   @param p - the first byte of the number                              
+   ///   @return the number in native byte order                              
+   template<Inner::EndianNumber T, CT::ByteLike B> NOD() LANGULUS(INLINED)
+   constexpr T LoadLE(const B* p) noexcept {
+      using U = Inner::EndianBits<sizeof(T)>;
+      IF_CONSTEXPR() {
+         U result {};
+         for (Offset i = 0; i < sizeof(T); ++i)
+            result |= static_cast<U>(static_cast<unsigned char>(p[i])) << (i * 8);
+         return ::std::bit_cast<T>(result);
+      }
+      else {
+         T result;
+         ::std::memcpy(&result, p, sizeof(T));
+         if constexpr (BigEndianMachine)
+            result = ByteSwap(result);
+         return result;
+      }
+   }
+
+   /// Read a big-endian number from memory, that may be unaligned            
+   /// Done byte by byte at compile-time, and via memcpy at runtime           
+   ///   @param p - the first byte of the number                              
+   ///   @return the number in native byte order                              
+   template<Inner::EndianNumber T, CT::ByteLike B> NOD() LANGULUS(INLINED)
+   constexpr T LoadBE(const B* p) noexcept {
+      using U = Inner::EndianBits<sizeof(T)>;
+      IF_CONSTEXPR() {
+         U result {};
+         for (Offset i = 0; i < sizeof(T); ++i)
+            result = static_cast<U>((result << 8) | static_cast<unsigned char>(p[i]));
+         return ::std::bit_cast<T>(result);
+      }
+      else {
+         T result;
+         ::std::memcpy(&result, p, sizeof(T));
+         if constexpr (LittleEndianMachine)
+            result = ByteSwap(result);
+         return result;
+      }
+   }
+
+   /// Write a number to memory in little-endian, that may be unaligned       
+   /// Done byte by byte at compile-time, and via memcpy at runtime           
+   ///   @param p - where to write the first byte                             
+   ///   @param value - the number in native byte order                       
+   template<Inner::EndianNumber T, CT::ByteLike B> LANGULUS(INLINED)
+   constexpr void StoreLE(B* p, const T value) noexcept {
+      IF_CONSTEXPR() {
+         const auto bits = ::std::bit_cast<Inner::EndianBits<sizeof(T)>>(value);
+         for (Offset i = 0; i < sizeof(T); ++i)
+            p[i] = static_cast<B>((bits >> (i * 8)) & 0xFF);
+      }
+      else {
+         const T ordered = BigEndianMachine ? ByteSwap(value) : value;
+         ::std::memcpy(p, &ordered, sizeof(T));
+      }
+   }
+
+   /// Write a number to memory in big-endian, that may be unaligned          
+   /// Done byte by byte at compile-time, and via memcpy at runtime           
+   ///   @param p - where to write the first byte                             
+   ///   @param value - the number in native byte order                       
+   template<Inner::EndianNumber T, CT::ByteLike B> LANGULUS(INLINED)
+   constexpr void StoreBE(B* p, const T value) noexcept {
+      IF_CONSTEXPR() {
+         const auto bits = ::std::bit_cast<Inner::EndianBits<sizeof(T)>>(value);
+         for (Offset i = 0; i < sizeof(T); ++i)
+            p[i] = static_cast<B>((bits >> ((sizeof(T) - 1 - i) * 8)) & 0xFF);
+      }
+      else {
+         const T ordered = LittleEndianMachine ? ByteSwap(value) : value;
+         ::std::memcpy(p, &ordered, sizeof(T));
+      }
+   }
+
+   namespace Inner
+   {
+
+      template<EndianNumber T>
+      void ByteSwapScalar(const T* input, T* output, const Count count) noexcept {
+         for (Offset i = 0; i < count; ++i)
+            output[i] = ByteSwap(input[i]);
+      }
+
+   #if LANGULUS_ARCH(X86)
+      /// Shuffle, that reverses the bytes of each T in a 64-byte register    
+      /// Byte shuffles don't cross 16-byte lanes, hence the modulo           
+      template<Offset SIZE>
+      constexpr auto ByteSwapShuffle = []() {
+         ::std::array<::std::int8_t, 64> result {};
+         for (Offset i = 0; i < 64; ++i)
+            result[i] = static_cast<::std::int8_t>((i % 16 / SIZE) * SIZE + (SIZE - 1 - i % SIZE));
+         return result;
+      }();
+
+      /// SSE2 has no byte shuffle, so bytes are swapped within words, after  
+      /// the words are reversed within each T                                
+      template<EndianNumber T> requires (sizeof(T) > 1) LANGULUS_TARGET(SSE2)
+      void ByteSwapSSE2(const T* input, T* output, const Count count) noexcept {
+         constexpr Count Lanes = 16 / sizeof(T);
+         Offset i = 0;
+         for (; i + Lanes <= count; i += Lanes) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            if constexpr (sizeof(T) == 4) {
+               x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+               x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+            }
+            else if constexpr (sizeof(T) == 8) {
+               x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(0, 1, 2, 3));
+               x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(0, 1, 2, 3));
+            }
+            x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), x);
+         }
+         ByteSwapScalar(input + i, output + i, count - i);
+      }
+
+      template<EndianNumber T> requires (sizeof(T) > 1) LANGULUS_TARGET(AVX2)
+      void ByteSwapAVX2(const T* input, T* output, const Count count) noexcept {
+         constexpr Count Lanes = 32 / sizeof(T);
+         const __m256i shuffle = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(ByteSwapShuffle<sizeof(T)>.data()));
+         Offset i = 0;
+         for (; i + Lanes <= count; i += Lanes) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_shuffle_epi8(x, shuffle));
+         }
+         ByteSwapScalar(input + i, output + i, count - i);
+      }
+
+      template<EndianNumber T> requires (sizeof(T) > 1) LANGULUS_TARGET(AVX512)
+      void ByteSwapAVX512(const T* input, T* output, const Count count) noexcept {
+         constexpr Count Lanes = 64 / sizeof(T);
+         const __m512i shuffle = _mm512_loadu_si512(ByteSwapShuffle<sizeof(T)>.data());
+         Offset i = 0;
+         for (; i + Lanes <= count; i += Lanes) {
+            const __m512i x = _mm512_loadu_si512(input + i);
+            _mm512_storeu_si512(output + i, _mm512_shuffle_epi8(x, shuffle));
+         }
+         ByteSwapAVX2(input + i, output + i, count - i);
+      }
+
+      template<EndianNumber T> requires (sizeof(T) > 1)
+      constexpr Multiversion<&ByteSwapScalar<T>, &ByteSwapSSE2<T>,
+         &ByteSwapAVX2<T>, &ByteSwapAVX512<T>> ByteSwapKernel;
+   #else
+      template<EndianNumber T> requires (sizeof(T) > 1)
+      constexpr Multiversion<&ByteSwapScalar<T>> ByteSwapKernel;
+   #endif
+
+   } // namespace Langulus::Inner
+
+
+   /// Reverse the bytes of each number in an array                           
+   /// Uses byte shuffles on AVX2 and AVX-512, if the host has them, and      
+   /// shifts on SSE2, picked on first call                                   
+   ///   @param input - the numbers                                           
+   ///   @param output - where to write results, can be the input, but must   
+   ///      not overlap it otherwise                                          
+   ///   @param count - number of elements                                    
+   template<Inner::EndianNumber T> LANGULUS(INLINED)
+   void ByteSwap(const T* input, T* output, const Count count) noexcept {
+      if constexpr (sizeof(T) == 1) {
+         if (input != output)
+            ::std::memcpy(output, input, count);
+      }
+      else Inner::ByteSwapKernel<T>(input, output, count);
+   }
+
+   /// Convert an array of numbers between native and little-endian order     
+   /// The conversion is the same in both directions                          
+   ///   @param input - the numbers                                           
+   ///   @param output - where to write results, can be the input, but must   
+   ///      not overlap it otherwise                                          
+   ///   @param count - number of elements                                    
+   template<Inner::EndianNumber T> LANGULUS(INLINED)
+   void ToLittleEndian(const T* input, T* output, const Count count) noexcept {
+      if constexpr (BigEndianMachine)
+         ByteSwap(input, output, count);
+      else if (input != output)
+         ::std::memcpy(output, input, count * sizeof(T));
+   }
+
+   /// Convert an array of numbers between native and big-endian order        
+   /// The conversion is the same in both directions                          
+   ///   @param input - the numbers                                           
+   ///   @param output - where to write results, can be the input, but must   
+   ///      not overlap it otherwise                                          
+   ///   @param count - number of elements                                    
+   template<Inner::EndianNumber T> LANGULUS(INLINED)
+   void ToBigEndian(const T* input, T* output, const Count count) noexcept {
+      if constexpr (LittleEndianMachine)
+         ByteSwap(input, output, count);
+      else if (input != output)
+         ::std::memcpy(output, input, count * sizeof(T));
+   }
+
+} // namespace Langulus
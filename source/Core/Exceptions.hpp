@@ -8,11 +8,39 @@
 #pragma once
 #include "Common.hpp"
 #include <stdexcept>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+
+/// The throw handler has to be shared by everything that is dynamically      
+/// linked, even when building with hidden visibility                         
+#if (LANGULUS_COMPILER(GCC) or LANGULUS_COMPILER(CLANG)) and not LANGULUS_OS(WINDOWS)
+   #define LANGULUS_THROW_API() __attribute__ ((visibility("default")))
+#else
+   #define LANGULUS_THROW_API()
+#endif
 
 
 namespace Langulus
 {
 
+   /// A compact numeric identifier of an exception type                      
+   using ErrorCategory = ::std::uint32_t;
+
+   namespace Inner
+   {
+      /// Get the category of an exception type from its name, so that it's   
+      /// the same in all shared libraries, without any registration          
+      ///   @param name - the name of the exception type                      
+      ///   @return the FNV-1a hash of the name                               
+      NOD() consteval ErrorCategory CategoryOf(const Token& name) noexcept {
+         ErrorCategory result = 0x811C9DC5u;
+         for (auto c : name)
+            result = (result ^ static_cast<unsigned char>(c)) * 0x01000193u;
+         return result;
+      }
+   }
+
    ///                                                                        
    ///   General exception                                                    
    ///                                                                        
@@ -29,12 +57,21 @@ namespace Langulus
       #endif
 
    public:
+      static constexpr ErrorCategory Category = 0;
+
       /// Get exception name                                                  
       ///   @return the name of the exception                                 
       virtual Token GetName() const noexcept {
          return "Unspecified";
       }
 
+      /// Get exception category, that is the same as the static Category     
+      /// of the most derived exception type                                  
+      ///   @return the category of the exception                             
+      virtual ErrorCategory GetCategory() const noexcept {
+         return Category;
+      }
+
    #if LANGULUS(DEBUG)
       /// Default exception constructor                                       
       LANGULUS(INLINED)
@@ -77,12 +114,61 @@ namespace Langulus
    #endif
    };
 
+   /// Called by Throw instead of throwing, when exceptions are disabled      
+   /// It must not return - the program is aborted if it does                 
+   using ThrowHandler = void (*)(const Exception&);
+
+   namespace Inner
+   {
+      /// Report the exception to stderr, and abort                           
+      [[noreturn]] LANGULUS(NOINLINE)
+      inline void DefaultThrowHandler(const Exception& exception) {
+         const auto name = exception.GetName();
+         #if LANGULUS(DEBUG)
+            const auto& message = exception.GetMessage();
+            const auto& location = exception.GetLocation();
+            ::std::fprintf(stderr, "Unhandled Except::%.*s at %.*s: %.*s\n",
+               static_cast<int>(name.size()), name.data(),
+               static_cast<int>(location.size()), location.data(),
+               static_cast<int>(message.size()), message.data());
+         #else
+            ::std::fprintf(stderr, "Unhandled Except::%.*s\n",
+               static_cast<int>(name.size()), name.data());
+         #endif
+         ::std::abort();
+      }
+
+      LANGULUS_THROW_API()
+      inline constinit ::std::atomic<ThrowHandler> CurrentThrowHandler {&DefaultThrowHandler};
+   }
+
+   /// Set the handler, that is called by Throw when exceptions are disabled  
+   /// It receives the exception, and must not return, so it can only log,    
+   /// crash, or jump away via longjmp                                        
+   ///   @param handler - the new handler, or nullptr for the default one     
+   ///   @return the previous handler                                         
+   LANGULUS(INLINED)
+   ThrowHandler SetThrowHandler(const ThrowHandler handler) noexcept {
+      return Inner::CurrentThrowHandler.exchange(
+         handler ? handler : &Inner::DefaultThrowHandler);
+   }
+
    /// Make sure this is not inlined as it is slow and dramatically enlarges  
    /// code, thus making other inlinings more difficult                       
    /// Throws are also generally the slow path                                
+   /// When exceptions are disabled, the exception is passed to the throw     
+   /// handler instead - see SetThrowHandler                                  
+   /// Not constexpr, so reaching it in a constant evaluation is a compile    
+   /// error, with or without exceptions                                      
    template <class E, class... Args>
    [[noreturn]] LANGULUS(NOINLINE) void Throw(Args&&... args) {
-      throw E {::std::forward<Args>(args)...};
+      #if LANGULUS(EXCEPTIONS)
+         throw E {::std::forward<Args>(args)...};
+      #else
+         const E exception {::std::forward<Args>(args)...};
+         Inner::CurrentThrowHandler.load(::std::memory_order_relaxed)(exception);
+         ::std::abort();
+      #endif
    }
 
    namespace CT
@@ -101,10 +187,15 @@ namespace Langulus
    namespace Langulus::Except \
    { \
       struct name : ::Langulus::Exception { \
+         static constexpr ::Langulus::ErrorCategory Category = \
+            ::Langulus::Inner::CategoryOf(#name); \
          using Exception::Exception; \
          Token GetName() const noexcept override { \
             return #name; \
          } \
+         ::Langulus::ErrorCategory GetCategory() const noexcept override { \
+            return Category; \
+         } \
       }; \
    }
 
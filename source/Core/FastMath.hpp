@@ -0,0 +1,608 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Simd.hpp"
+#include <limits>
+#include <utility>
+
+
+namespace Langulus
+{
+
+   /// Precision tiers of the fast math kernels                               
+   ///   Full - within a few ULP of the standard library                      
+   ///   Medium - relative error around 1e-4                                  
+   ///   Low - relative error around 1e-2                                     
+   /// Errors of FastSin and FastCos are absolute, instead of relative,       
+   /// because near their zeros the reduced argument loses relative bits      
+   enum class Precision {
+      Full, Medium, Low
+   };
+
+   namespace Inner
+   {
+
+      /// Reals, that the fast math kernels support                           
+      template<class T>
+      concept FastReal = CT::Exact<T, float> or CT::Exact<T, double>;
+
+      /// Layout of a real, and the constants its kernels reduce ranges with  
+      /// Constants split in hi/lo parts have enough zero bits in the hi      
+      /// parts, so that multiplying them by a reduced integer is exact       
+      template<FastReal T>
+      struct FastMathTraits;
+
+      template<>
+      struct FastMathTraits<float> {
+         using Bits = ::std::uint32_t;
+         using SignedBits = ::std::int32_t;
+         static constexpr int Mantissa = 23;
+         static constexpr Bits Bias = 127;
+         // Adding it rounds to an integer, that ends up in the low bits
+         static constexpr float Shifter = 0x1.8p23f;
+         static constexpr float Log2E = 0x1.715476p0f;
+         static constexpr float Ln2Hi = 0x1.62e4p-1f;
+         static constexpr float Ln2Lo = 0x1.7f7d1cp-20f;
+         static constexpr float InvPiHalf = 0x1.45f306p-1f;
+         static constexpr float PiHalf1 = 0x1.92p0f;
+         static constexpr float PiHalf2 = 0x1.fb4p-12f;
+         static constexpr float PiHalf3 = 0x1.4442d2p-24f;
+         // Bits of sqrt(0.5), where mantissas of logarithms are split  
+         static constexpr Bits SqrtHalf = 0x3f3504f3;
+         static constexpr Bits RSqrtMagic = 0x5f3759df;
+         // Exponents, for which 2^n stays a normal number              
+         static constexpr float ExpLimit = 87;
+         // Arguments, for which PiHalf1 and PiHalf2 products are exact 
+         static constexpr float TrigLimit = 8192;
+      };
+
+      template<>
+      struct FastMathTraits<double> {
+         using Bits = ::std::uint64_t;
+         using SignedBits = ::std::int64_t;
+         static constexpr int Mantissa = 52;
+         static constexpr Bits Bias = 1023;
+         // Adding it rounds to an integer, that ends up in the low bits
+         static constexpr double Shifter = 0x1.8p52;
+         static constexpr double Log2E = 0x1.71547652b82fep0;
+         static constexpr double Ln2Hi = 0x1.62e42fefa38p-1;
+         static constexpr double Ln2Lo = 0x1.ef35793c7673p-45;
+         static constexpr double InvPiHalf = 0x1.45f306dc9c883p-1;
+         static constexpr double PiHalf1 = 0x1.921fb544p0;
+         static constexpr double PiHalf2 = 0x1.0b4611a6p-34;
+         static constexpr double PiHalf3 = 0x1.3198a2e037073p-69;
+         // Bits of sqrt(0.5), where mantissas of logarithms are split  
+         static constexpr Bits SqrtHalf = 0x3fe6a09e667f3bcd;
+         static constexpr Bits RSqrtMagic = 0x5fe6eb50c7b537a9;
+         // Exponents, for which 2^n stays a normal number              
+         static constexpr double ExpLimit = 708;
+         // Arguments, for which PiHalf1 and PiHalf2 products are exact 
+         static constexpr double TrigLimit = 1e6;
+      };
+
+      /// Coefficients of a polynomial, lowest power first                    
+      template<class T, Count N>
+      struct FastMathSeries {
+         T mTerms[N];
+      };
+
+      /// Generate the coefficients of a power series                         
+      ///   @param term - makes the coefficient for a power, in double        
+      ///   @return the coefficients, rounded to T                            
+      template<class T, Count N, class F>
+      consteval FastMathSeries<T, N> MakeSeries(F&& term) {
+         FastMathSeries<T, N> series {};
+         for (Offset k = 0; k < N; ++k)
+            series.mTerms[k] = static_cast<T>(term(k));
+         return series;
+      }
+
+      /// k! in double, exact up to 22!                                       
+      constexpr double Factorial(const Offset k) {
+         double result = 1;
+         for (Offset i = 2; i <= k; ++i)
+            result *= static_cast<double>(i);
+         return result;
+      }
+
+      /// Coefficients of the Taylor series of exp(x), 1/k!                   
+      template<class T, Count N>
+      constexpr auto ExpSeries = MakeSeries<T, N>([](Offset k) {
+         return 1.0 / Factorial(k);
+      });
+
+      /// Coefficients of the Taylor series of sin(x)/x in x^2                
+      template<class T, Count N>
+      constexpr auto SinSeries = MakeSeries<T, N>([](Offset k) {
+         return (k % 2 ? -1.0 : 1.0) / Factorial(2 * k + 1);
+      });
+
+      /// Coefficients of the Taylor series of cos(x) in x^2                  
+      template<class T, Count N>
+      constexpr auto CosSeries = MakeSeries<T, N>([](Offset k) {
+         return (k % 2 ? -1.0 : 1.0) / Factorial(2 * k);
+      });
+
+      /// Coefficients of the Taylor series of 2*atanh(s)/s - 2 in s^2,       
+      /// which log(1+f) is made of, with s = f/(2+f)                         
+      template<class T, Count N>
+      constexpr auto LogSeries = MakeSeries<T, N>([](Offset k) {
+         return 2.0 / static_cast<double>(2 * k + 3);
+      });
+
+      /// Evaluate a polynomial with Horner's scheme, unrolled                
+      ///   @param x - the argument                                           
+      ///   @param series - the coefficients                                  
+      ///   @return the sum of series[k] * x^k                                
+      template<class V, class T, Count N, Offset... K> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr V Horner([[maybe_unused]] const V& x, const FastMathSeries<T, N>& series, ::std::index_sequence<K...>) noexcept {
+         V result = series.mTerms[N - 1];
+         ((result = result * x + series.mTerms[N - 2 - K]), ...);
+         return result;
+      }
+
+      template<class V, class T, Count N> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr V Horner(const V& x, const FastMathSeries<T, N>& series) noexcept {
+         return Horner(x, series, ::std::make_index_sequence<N - 1> {});
+      }
+
+      /// Get the bits of a real, or of each lane of a vector of reals        
+      template<FastReal T> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr auto AsBits(const T x) noexcept {
+         return ::std::bit_cast<typename FastMathTraits<T>::Bits>(x);
+      }
+
+      template<FastReal T, Count N> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr auto AsBits(const Simd<T, N>& x) noexcept {
+         return x.template Reinterpret<typename FastMathTraits<T>::Bits>();
+      }
+
+      /// Get the real from its bits, or a vector of reals from their bits    
+      template<FastReal T, CT::BuiltinInteger B> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr T AsReal(const B bits) noexcept {
+         return ::std::bit_cast<T>(bits);
+      }
+
+      template<FastReal T, CT::BuiltinInteger B, Count N> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr Simd<T, N> AsReal(const Simd<B, N>& bits) noexcept {
+         return bits.template Reinterpret<T>();
+      }
+
+      /// Check if a condition holds for a real, or for all lanes of a vector 
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr bool AllOf(const bool condition) noexcept {
+         return condition;
+      }
+
+      template<Count N> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr bool AllOf(const SimdMask<N>& condition) noexcept {
+         return condition.All();
+      }
+
+      /// Check if reals are positive normal numbers, that are not infinity   
+      ///   @tparam T - the type, whose limits to check against               
+      template<FastReal T, class V> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr auto IsPositiveNormal(const V& x) noexcept {
+         using L = ::std::numeric_limits<T>;
+         return (x >= L::min()) & (x <= L::max());
+      }
+
+      /// Round to the nearest integer, without converting to an integer      
+      ///   @param x - the reals to round, must be below 2^(Mantissa-1)       
+      ///   @param n - the integers, as reals                                 
+      ///   @return the integers, in the low bits of a two's complement       
+      template<FastReal T, class V> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr auto RoundToBits(const V& x, V& n) noexcept {
+         using B = FastMathTraits<T>;
+         const V shifted = x + B::Shifter;
+         n = shifted - B::Shifter;
+         return AsBits(shifted) - AsBits(B::Shifter);
+      }
+
+      /// Get small non-negative integers as reals                            
+      ///   @param bits - the integers, below 2^(Mantissa-1)                  
+      ///   @return the reals                                                 
+      template<FastReal T, class I> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr auto ToReal(const I& bits) noexcept {
+         using B = FastMathTraits<T>;
+         return AsReal<T>(bits + AsBits(B::Shifter)) - B::Shifter;
+      }
+
+      ///                                                                     
+      ///   Kernels of the fast math functions                                
+      ///                                                                     
+      /// Each kernel can check if its arguments are in the range it          
+      /// handles (Domain), compute its function in that range without any    
+      /// branching (Compute), and forward any other arguments to the         
+      /// standard library (Fallback). Domain and Compute work on a real,     
+      /// or on a Simd of reals, so that spans are processed a register at    
+      /// a time, while Real is the type they are done in                     
+      ///                                                                     
+      template<Precision P, FastReal T>
+      struct FastExpKernel {
+         using Real = T;
+         using B = FastMathTraits<T>;
+         static constexpr Count Terms = P == Precision::Low ? 3
+                                      : P == Precision::Medium ? 5
+                                      : CT::Exact<T, float> ? 8 : 14;
+
+         template<class V> NOD() LANGULUS(ALWAYS_INLINED)
+         static constexpr auto Domain(const V& x) noexcept {
+            return (x >= -B::ExpLimit) & (x <= B::ExpLimit);
+         }
+
+         /// exp(x) = 2^n * exp(r), where r = x - n*ln(2) is in               
+         /// [-ln(2)/2, ln(2)/2], so that the series converges quickly        
+         ///   @tparam N - number of terms of the series                      
+         template<Count N = Terms, class V> NOD() LANGULUS(ALWAYS_INLINED)
+         static constexpr V Compute(const V& x) noexcept {
+            V n;
+            const auto bits = RoundToBits<T>(x * B::Log2E, n);
+            const V r = x - n * B::Ln2Hi - n * B::Ln2Lo;
+            return Horner(r, ExpSeries<T, N>)
+                 * AsReal<T>((bits + B::Bias) << B::Mantissa);
+         }
+
+         NOD() LANGULUS(INLINED)
+         static T Fallback(const T x) noexcept {
+            return ::std::exp(x);
+         }
+      };
+
+      template<Precision P, FastReal T>
+      struct FastLogKernel {
+         using Real = T;
+         using B = FastMathTraits<T>;
+         static constexpr Count Terms = P == Precision::Low ? 1
+                                      : P == Precision::Medium ? 2
+                                      : CT::Exact<T, float> ? 4 : 10;
+
+         template<class V> NOD() LANGULUS(ALWAYS_INLINED)
+         static constexpr auto Domain(const V& x) noexcept {
+            return IsPositiveNormal<T>(x);
+         }
+
+         /// log(x) = e*ln(2) + log(1+f), where 1+f is the mantissa moved     
+         /// to [sqrt(0.5), sqrt(2)), so that the series converges quickly    
+         ///   @tparam N - number of terms of the series                      
+         template<Count N = Terms, class V> NOD() LANGULUS(ALWAYS_INLINED)
+         static constexpr V Compute(const V& x) noexcept {
+            constexpr auto MantissaMask = (typename B::Bits {1} << B::Mantissa) - 1;
+            const auto bits = AsBits(x) + (AsBits(T {1}) - B::SqrtHalf);
+            const V e = ToReal<T>(bits >> B::Mantissa) - static_cast<T>(B::Bias);
+            const V f = AsReal<T>((bits & MantissaMask) + B::SqrtHalf) - T {1};
+
+            // log(1+f) = 2*atanh(s) = f - s*(f - R), where s = f/(2+f) 
+            const V s = f / (f + T {2});
+            const V z = s * s;
+            const V R = z * Horner(z, LogSeries<T, N>);
+            return e * B::Ln2Hi + ((f - s * (f - R)) + e * B::Ln2Lo);
+         }
+
+         NOD() LANGULUS(INLINED)
+         static T Fallback(const T x) noexcept {
+            return ::std::log(x);
+         }
+      };
+
+      /// Sine and cosine share a kernel, that computes either of them        
+      template<Precision P, FastReal T, bool COSINE>
+      struct FastSinCosKernel {
+         using Real = T;
+         using B = FastMathTraits<T>;
+         using Bits = typename B::Bits;
+         static constexpr bool Wide = CT::Exact<T, double>;
+         static constexpr Count SinTerms = P == Precision::Low ? 2
+                                         : P == Precision::Medium ? 3
+                                         : Wide ? 9 : 5;
+         static constexpr Count CosTerms = P == Precision::Low ? 3
+                                         : P == Precision::Medium ? 4
+                                         : Wide ? 9 : 6;
+
+         template<class V> NOD() LANGULUS(ALWAYS_INLINED)
+         static constexpr auto Domain(const V& x) noexcept {
+            return (x >= -B::TrigLimit) & (x <= B::TrigLimit);
+         }
+
+         /// The argument is reduced to r = x - q*pi/2 in [-pi/4, pi/4],      
+         /// and the quadrant q picks the series and the sign                 
+         template<class V> NOD() LANGULUS(ALWAYS_INLINED)
+         static constexpr V Compute(const V& x) noexcept {
+            V q;
+            const auto quadrant = RoundToBits<T>(x * B::InvPiHalf, q)
+                                + static_cast<Bits>(COSINE);
+            const V r = x - q * B::PiHalf1 - q * B::PiHalf2 - q * B::PiHalf3;
+            const V z = r * r;
+            const auto sin = AsBits(r * Horner(z, SinSeries<T, SinTerms>));
+            const auto cos = AsBits(Horner(z, CosSeries<T, CosTerms>));
+
+            // Odd quadrants pick cosine, the upper two flip the sign   
+            using I = Deref<decltype(quadrant)>;
+            const auto odd = I {} - (quadrant & Bits {1});
+            const auto sign = (quadrant & Bits {2}) << (sizeof(T) * 8 - 2);
+            return AsReal<T>((sin ^ ((sin ^ cos) & odd)) ^ sign);
+         }
+
+         NOD() LANGULUS(INLINED)
+         static T Fallback(const T x) noexcept {
+            if constexpr (COSINE)
+               return ::std::cos(x);
+            else
+               return ::std::sin(x);
+         }
+      };
+
+      template<Precision P, FastReal T>
+      struct FastRSqrtKernel {
+         using Real = T;
+         using B = FastMathTraits<T>;
+
+         template<class V> NOD() LANGULUS(ALWAYS_INLINED)
+         static constexpr auto Domain(const V& x) noexcept {
+            return IsPositiveNormal<T>(x);
+         }
+
+         /// A guess from the bits of the argument, refined by one Newton     
+         /// iteration per tier, or an exact division for full precision      
+         template<class V> NOD() LANGULUS(ALWAYS_INLINED)
+         static constexpr V Compute(const V& x) noexcept {
+            if constexpr (P == Precision::Full) {
+               if constexpr (CT::Exact<V, T>)
+                  return Fallback(x);
+               else
+                  return T {1} / Sqrt(x);
+            }
+            else {
+               using I = Deref<decltype(AsBits(x))>;
+               V y = AsReal<T>(I {B::RSqrtMagic} - (AsBits(x) >> 1));
+               const V half = x * T {0.5};
+               y = y * (T {1.5} - half * y * y);
+               if constexpr (P == Precision::Medium)
+                  y = y * (T {1.5} - half * y * y);
+               return y;
+            }
+         }
+
+         NOD() LANGULUS(INLINED)
+         static T Fallback(const T x) noexcept {
+            return T {1} / ::std::sqrt(x);
+         }
+      };
+
+      template<Precision P, FastReal T>
+      struct FastPowKernel {
+         // Full precision computes float powers in double, where the   
+         // logarithm is precise enough not to be amplified by y, while 
+         // the exponential needs only as many terms as a float does    
+         using Real = Conditional<P == Precision::Full, double, T>;
+         using B = FastMathTraits<Real>;
+         static_assert(P != Precision::Full or CT::Exact<T, float>,
+            "Full precision powers of double need more than double");
+         static constexpr Count ExpTerms = FastExpKernel<P, T>::Terms;
+         static constexpr Count LogTerms = P == Precision::Full ? 6
+                                         : FastLogKernel<P, T>::Terms;
+
+         /// log(x) is in [e*ln(2), (e+1)*ln(2)], where e is the exponent     
+         /// of x, so y*log(x) is in range, if both ends of that are          
+         template<class V> NOD() LANGULUS(ALWAYS_INLINED)
+         static constexpr auto Domain(const V& x, const V& y) noexcept {
+            constexpr Real Limit = FastMathTraits<T>::ExpLimit;
+            const V e = ToReal<Real>(AsBits(x) >> B::Mantissa) - static_cast<Real>(B::Bias);
+            const V lo = y * e * B::Ln2Hi;
+            const V hi = lo + y * B::Ln2Hi;
+            return IsPositiveNormal<T>(x)
+               & (lo >= -Limit) & (lo <= Limit)
+               & (hi >= -Limit) & (hi <= Limit);
+         }
+
+         /// x^y = exp(y*log(x)), where the error of the logarithm grows      
+         /// with y*log(x), which lower tiers don't compensate for            
+         template<class V> NOD() LANGULUS(ALWAYS_INLINED)
+         static constexpr V Compute(const V& x, const V& y) noexcept {
+            return FastExpKernel<P, Real>::template Compute<ExpTerms>(
+               y * FastLogKernel<P, Real>::template Compute<LogTerms>(x));
+         }
+
+         NOD() LANGULUS(INLINED)
+         static T Fallback(const T x, const T y) noexcept {
+            return ::std::pow(x, y);
+         }
+      };
+
+      /// Apply a kernel to a single set of arguments                         
+      template<class K, FastReal T, CT::Exact<T>... A> NOD() LANGULUS(INLINED)
+      constexpr T FastMathScalar(const T x, const A... rest) noexcept {
+         using R = typename K::Real;
+         if (K::Domain(static_cast<R>(x), static_cast<R>(rest)...)) LIKELY()
+            return static_cast<T>(K::Compute(static_cast<R>(x), static_cast<R>(rest)...));
+         return K::Fallback(x, rest...);
+      }
+
+      /// Load a vector of the type a kernel works in                         
+      template<class V, FastReal T> NOD() LANGULUS(ALWAYS_INLINED)
+      V FastMathLoad(const T* source) noexcept {
+         if constexpr (CT::Exact<typename V::Type, T>)
+            return V::Load(source);
+         else return [&]<Offset... I>(::std::index_sequence<I...>) {
+            return V {static_cast<typename V::Type>(source[I])...};
+         }(::std::make_index_sequence<V::Lanes> {});
+      }
+
+      /// Store a vector of the type a kernel works in                        
+      template<class V, FastReal T> LANGULUS(ALWAYS_INLINED)
+      void FastMathStore(const V& value, T* target) noexcept {
+         if constexpr (CT::Exact<typename V::Type, T>)
+            value.Store(target);
+         else {
+            typename V::Type converted[V::Lanes];
+            value.Store(converted);
+            for (Offset i = 0; i < V::Lanes; ++i)
+               target[i] = static_cast<T>(converted[i]);
+         }
+      }
+
+      /// Apply a kernel to a register of arguments, or to each of them one   
+      /// by one, if any is outside of the domain of the kernel               
+      template<class K, FastReal T, class V, CT::Exact<V>... A> LANGULUS(ALWAYS_INLINED)
+      void FastMathVector(T* output, const V& x, const A&... rest) noexcept {
+         if (AllOf(K::Domain(x, rest...))) LIKELY()
+            FastMathStore(K::Compute(x, rest...), output);
+         else for (Offset i = 0; i < V::Lanes; ++i)
+            output[i] = FastMathScalar<K>(static_cast<T>(x[i]), static_cast<T>(rest[i])...);
+      }
+
+      /// Apply a kernel to spans of arguments, a register at a time          
+      ///   @param output - where to write results, may be one of inputs      
+      ///   @param count - number of results                                  
+      ///   @param inputs - the arguments, count of each                      
+      template<class K, FastReal T, CT::Exact<T>... A>
+      void FastMathMap(T* output, const Count count, const A*... inputs) noexcept {
+         using R = typename K::Real;
+         Offset i = 0;
+
+         if constexpr (SimdWidth / sizeof(R) > 1) {
+            using V = Simd<R, SimdWidth / sizeof(R)>;
+            for (; i + V::Lanes <= count; i += V::Lanes)
+               FastMathVector<K>(output + i, FastMathLoad<V>(inputs + i)...);
+         }
+
+         for (; i < count; ++i)
+            output[i] = FastMathScalar<K>(inputs[i]...);
+      }
+
+   } // namespace Langulus::Inner
+
+
+   /// Fast e^x                                                               
+   ///   @tparam P - the precision tier                                       
+   ///   @param x - the exponent                                              
+   ///   @return e^x                                                          
+   template<Precision P = Precision::Full, Inner::FastReal T> NOD() LANGULUS(INLINED)
+   constexpr T FastExp(const T x) noexcept {
+      return Inner::FastMathScalar<Inner::FastExpKernel<P, T>>(x);
+   }
+
+   /// Fast e^x over a span, vectorized at SIMD width                         
+   ///   @tparam P - the precision tier                                       
+   ///   @param input - the exponents                                         
+   ///   @param output - where to write results, can be the input             
+   ///   @param count - number of elements                                    
+   template<Precision P = Precision::Full, Inner::FastReal T> LANGULUS(INLINED)
+   void FastExp(const T* input, T* output, const Count count) noexcept {
+      Inner::FastMathMap<Inner::FastExpKernel<P, T>>(output, count, input);
+   }
+
+   /// Fast natural logarithm                                                 
+   ///   @tparam P - the precision tier                                       
+   ///   @param x - the argument                                              
+   ///   @return log(x)                                                       
+   template<Precision P = Precision::Full, Inner::FastReal T> NOD() LANGULUS(INLINED)
+   constexpr T FastLog(const T x) noexcept {
+      return Inner::FastMathScalar<Inner::FastLogKernel<P, T>>(x);
+   }
+
+   /// Fast natural logarithm over a span, vectorized at SIMD width           
+   ///   @tparam P - the precision tier                                       
+   ///   @param input - the arguments                                         
+   ///   @param output - where to write results, can be the input             
+   ///   @param count - number of elements                                    
+   template<Precision P = Precision::Full, Inner::FastReal T> LANGULUS(INLINED)
+   void FastLog(const T* input, T* output, const Count count) noexcept {
+      Inner::FastMathMap<Inner::FastLogKernel<P, T>>(output, count, input);
+   }
+
+   /// Fast sine                                                              
+   ///   @tparam P - the precision tier                                       
+   ///   @param x - the angle in radians                                      
+   ///   @return sin(x)                                                       
+   template<Precision P = Precision::Full, Inner::FastReal T> NOD() LANGULUS(INLINED)
+   constexpr T FastSin(const T x) noexcept {
+      return Inner::FastMathScalar<Inner::FastSinCosKernel<P, T, false>>(x);
+   }
+
+   /// Fast sine over a span, vectorized at SIMD width                        
+   ///   @tparam P - the precision tier                                       
+   ///   @param input - the angles in radians                                 
+   ///   @param output - where to write results, can be the input             
+   ///   @param count - number of elements                                    
+   template<Precision P = Precision::Full, Inner::FastReal T> LANGULUS(INLINED)
+   void FastSin(const T* input, T* output, const Count count) noexcept {
+      Inner::FastMathMap<Inner::FastSinCosKernel<P, T, false>>(output, count, input);
+   }
+
+   /// Fast cosine                                                            
+   ///   @tparam P - the precision tier                                       
+   ///   @param x - the angle in radians                                      
+   ///   @return cos(x)                                                       
+   template<Precision P = Precision::Full, Inner::FastReal T> NOD() LANGULUS(INLINED)
+   constexpr T FastCos(const T x) noexcept {
+      return Inner::FastMathScalar<Inner::FastSinCosKernel<P, T, true>>(x);
+   }
+
+   /// Fast cosine over a span, vectorized at SIMD width                      
+   ///   @tparam P - the precision tier                                       
+   ///   @param input - the angles in radians                                 
+   ///   @param output - where to write results, can be the input             
+   ///   @param count - number of elements                                    
+   template<Precision P = Precision::Full, Inner::FastReal T> LANGULUS(INLINED)
+   void FastCos(const T* input, T* output, const Count count) noexcept {
+      Inner::FastMathMap<Inner::FastSinCosKernel<P, T, true>>(output, count, input);
+   }
+
+   /// Fast 1/sqrt(x)                                                         
+   ///   @tparam P - the precision tier                                       
+   ///   @param x - the argument                                              
+   ///   @return 1/sqrt(x)                                                    
+   template<Precision P = Precision::Full, Inner::FastReal T> NOD() LANGULUS(INLINED)
+   constexpr T FastRSqrt(const T x) noexcept {
+      return Inner::FastMathScalar<Inner::FastRSqrtKernel<P, T>>(x);
+   }
+
+   /// Fast 1/sqrt(x) over a span, vectorized at SIMD width                   
+   ///   @tparam P - the precision tier                                       
+   ///   @param input - the arguments                                         
+   ///   @param output - where to write results, can be the input             
+   ///   @param count - number of elements                                    
+   template<Precision P = Precision::Full, Inner::FastReal T> LANGULUS(INLINED)
+   void FastRSqrt(const T* input, T* output, const Count count) noexcept {
+      Inner::FastMathMap<Inner::FastRSqrtKernel<P, T>>(output, count, input);
+   }
+
+   /// Fast x^y                                                               
+   ///   @attention the full precision tier of double is the standard         
+   ///              library's pow, because it needs more than double          
+   ///   @tparam P - the precision tier                                       
+   ///   @param x - the base                                                  
+   ///   @param y - the exponent                                              
+   ///   @return x^y                                                          
+   template<Precision P = Precision::Full, Inner::FastReal T> NOD() LANGULUS(INLINED)
+   constexpr T FastPow(const T x, const T y) noexcept {
+      if constexpr (P == Precision::Full and CT::Exact<T, double>)
+         return ::std::pow(x, y);
+      else
+         return Inner::FastMathScalar<Inner::FastPowKernel<P, T>>(x, y);
+   }
+
+   /// Fast x^y over spans, vectorized at SIMD width                          
+   ///   @attention the full precision tier of double is the standard         
+   ///              library's pow, because it needs more than double          
+   ///   @tparam P - the precision tier                                       
+   ///   @param base - the bases                                              
+   ///   @param exponent - the exponents                                      
+   ///   @param output - where to write results, can be one of the inputs     
+   ///   @param count - number of elements                                    
+   template<Precision P = Precision::Full, Inner::FastReal T> LANGULUS(INLINED)
+   void FastPow(const T* base, const T* exponent, T* output, const Count count) noexcept {
+      if constexpr (P == Precision::Full and CT::Exact<T, double>) {
+         for (Offset i = 0; i < count; ++i)
+            output[i] = ::std::pow(base[i], exponent[i]);
+      }
+      else Inner::FastMathMap<Inner::FastPowKernel<P, T>>(output, count, base, exponent);
+   }
+
+} // namespace Langulus
@@ -0,0 +1,342 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Hash.hpp"
+#include <utility>
+
+
+namespace Langulus
+{
+
+   namespace CT
+   {
+      /// Check if all T can be keys in a FrozenMap or a FrozenSet            
+      template<class...T>
+      concept FrozenKey = sizeof...(T) > 0
+          and ((BuiltinInteger<T> or Exact<T, Token>) and ...);
+   }
+
+   namespace Inner
+   {
+
+      /// Marks displacements, that point directly to a slot                  
+      constexpr ::std::uint64_t FrozenDirect = ::std::uint64_t {1} << 63;
+      /// How many displacements to try for a bucket, before giving up on     
+      /// the current seed                                                    
+      constexpr ::std::uint64_t FrozenDisplacements = 1 << 16;
+      /// How many seeds to try, before giving up on the whole set of keys    
+      constexpr ::std::uint64_t FrozenSeeds = 64;
+
+      /// Hash a key, the same way at compile-time and at runtime             
+      template<CT::FrozenKey K> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr ::std::uint64_t FrozenHash(const K& key, const ::std::uint64_t seed) noexcept {
+         if constexpr (CT::BuiltinInteger<K>)
+            return HashMix(static_cast<::std::uint64_t>(key) ^ seed ^ HashP0, HashP1);
+         else
+            return HashBytes(key.data(), key.size(), seed).mHash;
+      }
+
+      /// Pick a slot for a hash, using a displacement                        
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr ::std::uint64_t FrozenDisplace(
+         const ::std::uint64_t hash, const ::std::uint64_t displacement
+      ) noexcept {
+         return HashMix(hash ^ HashP2, displacement ^ HashP3);
+      }
+
+      ///                                                                     
+      ///   Perfect hash index over a fixed set of keys                       
+      ///                                                                     
+      /// Uses hash-and-displace: keys are hashed once into buckets, then each
+      /// bucket gets a displacement, that scatters its keys into free slots. 
+      /// Buckets with a single key point directly to a free slot instead.    
+      /// Finding a key takes one hash, two table reads and one compare       
+      ///                                                                     
+      template<CT::FrozenKey K, Count N>
+      class FrozenIndex {
+      public:
+         static constexpr Count Slots = N > 1 ? Roof2(N) : 1;
+         static constexpr Count Mask = Slots - 1;
+
+      private:
+         // The seed, that worked for the first hash                    
+         ::std::uint64_t mSeed {};
+         // Displacement of each bucket                                 
+         ::std::array<::std::uint64_t, Slots> mDisplacements {};
+         // Key index in each slot, or N if the slot is empty           
+         ::std::array<Count, Slots> mSlots {};
+
+      public:
+         /// Build the index at compile-time                                  
+         ///   @param keys - the keys, must all be different                  
+         ///   @attention fails to compile if keys repeat                     
+         constexpr explicit FrozenIndex(const ::std::array<K, N>& keys) {
+            for (::std::uint64_t seed = 0; seed < FrozenSeeds; ++seed) {
+               if (Build(keys, HashP0 + seed * HashP1))
+                  return;
+            }
+            Throw<Except::Construct>("Can't build a perfect hash for these keys", LANGULUS_LOCATION());
+         }
+
+         /// Find the index of a key                                          
+         ///   @param keys - the same keys, that the index was built from     
+         ///   @param key - the key to search for                             
+         ///   @return the index of the key, or N if not found                
+         NOD() LANGULUS(INLINED)
+         constexpr Count Find(const ::std::array<K, N>& keys, const K& key) const noexcept {
+            const auto hash = FrozenHash(key, mSeed);
+            const auto displacement = mDisplacements[hash & Mask];
+            const auto slot = displacement & FrozenDirect
+               ? displacement ^ FrozenDirect
+               : FrozenDisplace(hash, displacement) & Mask;
+            const auto index = mSlots[slot];
+            return index < N and keys[index] == key ? index : N;
+         }
+
+      private:
+         /// Try building the index with a seed                               
+         ///   @return true on success, false if the seed is no good          
+         constexpr bool Build(const ::std::array<K, N>& keys, const ::std::uint64_t seed) {
+            mSeed = seed;
+            mDisplacements.fill(FrozenDirect);
+            mSlots.fill(N);
+
+            // Sort keys by bucket, and buckets by size, biggest first  
+            ::std::array<::std::uint64_t, N> hashes {};
+            ::std::array<Count, Slots + 1> starts {};
+            for (Count i = 0; i < N; ++i) {
+               hashes[i] = FrozenHash(keys[i], seed);
+               ++starts[(hashes[i] & Mask) + 1];
+            }
+
+            ::std::array<Count, N + 1> bySize {};
+            for (Count b = 0; b < Slots; ++b)
+               ++bySize[starts[b + 1]];
+            for (Count s = N; s > 0; --s)
+               bySize[s - 1] += bySize[s];
+            for (Count b = 0; b < Slots; ++b)
+               starts[b + 1] += starts[b];
+
+            ::std::array<Count, N> members {};
+            ::std::array<Count, Slots> fill {};
+            for (Count i = 0; i < N; ++i) {
+               const auto b = hashes[i] & Mask;
+               members[starts[b] + fill[b]++] = i;
+            }
+
+            ::std::array<Count, Slots> buckets {};
+            for (Count b = 0; b < Slots; ++b)
+               buckets[--bySize[starts[b + 1] - starts[b]]] = b;
+
+            // Displace the crowded buckets, while there's room         
+            Count nextFree = 0;
+            for (const auto b : buckets) {
+               const auto first = starts[b];
+               const auto count = starts[b + 1] - first;
+               if (count == 0)
+                  break;
+
+               if (count == 1) {
+                  while (mSlots[nextFree] != N)
+                     ++nextFree;
+                  mSlots[nextFree] = members[first];
+                  mDisplacements[b] = FrozenDirect | nextFree;
+                  continue;
+               }
+
+               for (Count i = first; i < first + count; ++i) {
+                  for (Count j = i + 1; j < first + count; ++j) {
+                     if (keys[members[i]] == keys[members[j]])
+                        Throw<Except::Construct>("Frozen keys must be unique", LANGULUS_LOCATION());
+                  }
+               }
+
+               if (not Displace(hashes, members, first, count, b))
+                  return false;
+            }
+            return true;
+         }
+
+         /// Find a displacement, that puts all keys of a bucket into free    
+         /// slots, and occupy them                                           
+         ///   @return true on success                                        
+         constexpr bool Displace(
+            const ::std::array<::std::uint64_t, N>& hashes,
+            const ::std::array<Count, N>& members,
+            const Count first, const Count count, const Count bucket
+         ) {
+            for (::std::uint64_t d = 1; d < FrozenDisplacements; ++d) {
+               Count placed = 0;
+               while (placed < count) {
+                  const auto key = members[first + placed];
+                  const auto slot = FrozenDisplace(hashes[key], d) & Mask;
+                  if (mSlots[slot] != N)
+                     break;
+                  mSlots[slot] = key;
+                  ++placed;
+               }
+
+               if (placed == count) {
+                  mDisplacements[bucket] = d;
+                  return true;
+               }
+
+               // Free whatever we managed to place, and try again      
+               while (placed > 0) {
+                  const auto key = members[first + --placed];
+                  mSlots[FrozenDisplace(hashes[key], d) & Mask] = N;
+               }
+            }
+            return false;
+         }
+      };
+
+   } // namespace Langulus::Inner
+
+
+   ///                                                                        
+   ///   Immutable set with a perfect hash                                    
+   ///                                                                        
+   /// Built at compile-time from a fixed set of integers or Tokens. Lookups  
+   /// are a single probe, without any heap memory, so it is a cheap          
+   /// replacement for runtime hash sets of names, verbs and traits:          
+   ///                                                                        
+   ///   constexpr auto verbs = MakeFrozenSet<Token>({"Create", "Select"});   
+   ///   static_assert(verbs.Contains("Create"));                             
+   ///                                                                        
+   template<CT::FrozenKey K, Count N>
+   class FrozenSet {
+      ::std::array<K, N> mKeys;
+      Inner::FrozenIndex<K, N> mIndex;
+
+   public:
+      /// Build a set from keys, in a constant expression if possible         
+      ///   @param keys - the keys, must be unique                            
+      constexpr explicit FrozenSet(const ::std::array<K, N>& keys)
+         : mKeys {keys}
+         , mIndex {mKeys} {}
+
+      /// Check if the set contains a key                                     
+      NOD() LANGULUS(INLINED)
+      constexpr bool Contains(const K& key) const noexcept {
+         return mIndex.Find(mKeys, key) != N;
+      }
+
+      /// Get the index of a key, in the order the keys were given            
+      ///   @return the index, or N if the key isn't in the set               
+      NOD() LANGULUS(INLINED)
+      constexpr Offset Find(const K& key) const noexcept {
+         return mIndex.Find(mKeys, key);
+      }
+
+      NOD() LANGULUS(INLINED)
+      static constexpr Count GetCount() noexcept {
+         return N;
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr auto begin() const noexcept {
+         return mKeys.begin();
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr auto end() const noexcept {
+         return mKeys.end();
+      }
+   };
+
+   ///                                                                        
+   ///   Immutable map with a perfect hash                                    
+   ///                                                                        
+   /// Built at compile-time from a fixed set of integer or Token keys, and   
+   /// their values. Lookups are a single probe, without any heap memory:     
+   ///                                                                        
+   ///   constexpr auto traits = MakeFrozenMap<Token, int>({                  
+   ///      {"Position", 0}, {"Velocity", 1}, {"Mass", 2}                     
+   ///   });                                                                  
+   ///   static_assert(*traits.Find("Mass") == 2);                            
+   ///                                                                        
+   template<CT::FrozenKey K, class V, Count N>
+   class FrozenMap {
+      ::std::array<K, N> mKeys;
+      ::std::array<V, N> mValues;
+      Inner::FrozenIndex<K, N> mIndex;
+
+   public:
+      /// Build a map from keys and their values, in a constant expression    
+      /// if possible                                                         
+      ///   @param keys - the keys, must be unique                            
+      ///   @param values - the values, in the same order as the keys         
+      constexpr FrozenMap(const ::std::array<K, N>& keys, const ::std::array<V, N>& values)
+         : mKeys {keys}
+         , mValues {values}
+         , mIndex {mKeys} {}
+
+      /// Check if the map contains a key                                     
+      NOD() LANGULUS(INLINED)
+      constexpr bool Contains(const K& key) const noexcept {
+         return mIndex.Find(mKeys, key) != N;
+      }
+
+      /// Find the value of a key                                             
+      ///   @return a pointer to the value, or nullptr if key isn't mapped    
+      NOD() LANGULUS(INLINED)
+      constexpr const V* Find(const K& key) const noexcept {
+         const auto index = mIndex.Find(mKeys, key);
+         return index != N ? &mValues[index] : nullptr;
+      }
+
+      /// Get the value of a key                                              
+      ///   @attention throws Except::OutOfRange if key isn't mapped          
+      NOD() LANGULUS(INLINED)
+      constexpr const V& operator[] (const K& key) const {
+         const auto index = mIndex.Find(mKeys, key);
+         if (index == N)
+            Throw<Except::OutOfRange>("Key is not in the frozen map", LANGULUS_LOCATION());
+         return mValues[index];
+      }
+
+      NOD() LANGULUS(INLINED)
+      static constexpr Count GetCount() noexcept {
+         return N;
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr const ::std::array<K, N>& GetKeys() const noexcept {
+         return mKeys;
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr const ::std::array<V, N>& GetValues() const noexcept {
+         return mValues;
+      }
+   };
+
+   /// Build a FrozenSet at compile-time                                      
+   ///   @param keys - the keys, must be unique                               
+   ///   @return the set                                                      
+   template<CT::FrozenKey K, Count N> NOD()
+   consteval auto MakeFrozenSet(const K(&keys)[N]) {
+      return FrozenSet<K, N> {::std::to_array(keys)};
+   }
+
+   /// Build a FrozenMap at compile-time                                      
+   ///   @param pairs - the keys and their values, keys must be unique        
+   ///   @return the map                                                      
+   template<CT::FrozenKey K, class V, Count N> NOD()
+   consteval auto MakeFrozenMap(const ::std::pair<K, V>(&pairs)[N]) {
+      ::std::array<K, N> keys {};
+      ::std::array<V, N> values {};
+      for (Count i = 0; i < N; ++i) {
+         keys[i] = pairs[i].first;
+         values[i] = pairs[i].second;
+      }
+      return FrozenMap<K, V, N> {keys, values};
+   }
+
+} // namespace Langulus
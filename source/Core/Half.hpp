@@ -0,0 +1,446 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Multiversion.hpp"
+
+#if LANGULUS_ARCH(X86)
+   #include <immintrin.h>
+#endif
+
+
+namespace Langulus
+{
+   namespace Inner
+   {
+
+      /// Convert a float to IEEE 754 binary16 bits                           
+      /// Rounds to nearest even, overflows to infinity, keeps subnormals,    
+      /// and quiets NaNs, keeping the top bits of their payload - same as    
+      /// the F16C instructions do                                            
+      ///   @param value - the float to convert                               
+      ///   @return the half-precision bits                                   
+      NOD() LANGULUS(INLINED)
+      constexpr ::std::uint16_t F32ToF16(const Float value) noexcept {
+         const auto bits = ::std::bit_cast<::std::uint32_t>(value);
+         const auto sign = static_cast<::std::uint16_t>((bits >> 16) & 0x8000);
+         const auto abs = bits & 0x7FFFFFFFu;
+
+         if (abs > 0x7F800000u) {
+            // NaN                                                      
+            return static_cast<::std::uint16_t>(
+               sign | 0x7E00 | ((abs >> 13) & 0x3FF));
+         }
+
+         if (abs >= 0x47800000u) {
+            // 2^16 and above is infinity, anything below that, which   
+            // rounds up to 2^16, carries into the exponent by itself   
+            return static_cast<::std::uint16_t>(sign | 0x7C00);
+         }
+
+         if (abs < 0x38800000u) {
+            // Below 2^-14 halves are subnormal, in units of 2^-24, so  
+            // half of a unit and below rounds to zero                  
+            if (abs <= 0x33000000u)
+               return sign;
+
+            const auto exponent = abs >> 23;
+            const auto mantissa = (abs & 0x7FFFFFu) | 0x800000u;
+            const auto shift = 126 - exponent;
+            const auto halfway = 1u << (shift - 1);
+            const auto remainder = mantissa & ((1u << shift) - 1);
+            auto result = mantissa >> shift;
+            if (remainder > halfway or (remainder == halfway and (result & 1)))
+               ++result;
+            return static_cast<::std::uint16_t>(sign | result);
+         }
+
+         // Rebias the exponent from 127 to 15, and round the 13 bits,  
+         // that don't fit, to nearest even                             
+         const auto rebiased = abs - 0x38000000u;
+         return static_cast<::std::uint16_t>(sign |
+            ((rebiased + 0xFFF + ((rebiased >> 13) & 1)) >> 13));
+      }
+
+      /// Convert IEEE 754 binary16 bits to a float - it is always exact,     
+      /// except that NaNs are quieted, as the F16C instructions do           
+      ///   @param half - the half-precision bits                             
+      ///   @return the float                                                 
+      NOD() LANGULUS(INLINED)
+      constexpr Float F16ToF32(const ::std::uint16_t half) noexcept {
+         const auto sign = static_cast<::std::uint32_t>(half & 0x8000) << 16;
+         const auto exponent = (half >> 10) & 0x1F;
+         auto mantissa = static_cast<::std::uint32_t>(half & 0x3FF);
+
+         if (exponent == 0x1F) {
+            // Infinity or NaN                                          
+            return ::std::bit_cast<Float>(sign | 0x7F800000u | (mantissa << 13)
+               | (mantissa ? 0x400000u : 0u));
+         }
+
+         if (exponent == 0) {
+            if (mantissa == 0)
+               return ::std::bit_cast<Float>(sign);
+
+            // Subnormal half, which is a normal float - normalize it   
+            ::std::uint32_t e = 113;
+            while (not (mantissa & 0x400)) {
+               mantissa <<= 1;
+               --e;
+            }
+            return ::std::bit_cast<Float>(sign | (e << 23) | ((mantissa & 0x3FF) << 13));
+         }
+
+         return ::std::bit_cast<Float>(sign
+            | (static_cast<::std::uint32_t>(exponent + 112) << 23) | (mantissa << 13));
+      }
+
+      /// Convert a float to bfloat16 bits                                    
+      /// Drops the lower 16 bits of the mantissa, rounding to nearest even,  
+      /// and quiets NaNs, so that they don't turn into infinities            
+      ///   @param value - the float to convert                               
+      ///   @return the bfloat16 bits                                         
+      NOD() LANGULUS(INLINED)
+      constexpr ::std::uint16_t F32ToBF16(const Float value) noexcept {
+         const auto bits = ::std::bit_cast<::std::uint32_t>(value);
+         if ((bits & 0x7FFFFFFFu) > 0x7F800000u)
+            return static_cast<::std::uint16_t>((bits >> 16) | 0x40);
+         return static_cast<::std::uint16_t>(
+            (bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);
+      }
+
+      /// Convert bfloat16 bits to a float - it is always exact               
+      ///   @param half - the bfloat16 bits                                   
+      ///   @return the float                                                 
+      NOD() LANGULUS(INLINED)
+      constexpr Float BF16ToF32(const ::std::uint16_t half) noexcept {
+         return ::std::bit_cast<Float>(static_cast<::std::uint32_t>(half) << 16);
+      }
+
+   } // namespace Langulus::Inner
+
+
+   ///                                                                        
+   ///   IEEE 754 half-precision float                                        
+   ///                                                                        
+   /// A storage type - convert it to Float for arithmetic. Has 11 bits of    
+   /// precision and a range of +-65504, which is enough for colors, normals  
+   /// and most vertex attributes. Use ToHalf and ToFloat for arrays          
+   ///                                                                        
+   struct Half {
+      static constexpr bool CTTI_POD = true;
+      static constexpr bool CTTI_Nullifiable = true;
+
+      ::std::uint16_t mBits {};
+
+      constexpr Half() noexcept = default;
+      constexpr Half(const Half&) noexcept = default;
+
+      /// Convert a float, rounding to nearest even                           
+      LANGULUS(ALWAYS_INLINED)
+      explicit constexpr Half(const Float value) noexcept
+         : mBits {Inner::F32ToF16(value)} {}
+
+      /// Create from raw binary16 bits                                       
+      NOD() LANGULUS(ALWAYS_INLINED)
+      static constexpr Half FromBits(const ::std::uint16_t bits) noexcept {
+         Half result;
+         result.mBits = bits;
+         return result;
+      }
+
+      /// Every half is exactly representable as a float                      
+      LANGULUS(ALWAYS_INLINED)
+      constexpr operator Float() const noexcept {
+         return Inner::F16ToF32(mBits);
+      }
+
+      constexpr Half& operator = (const Half&) noexcept = default;
+   };
+
+   ///                                                                        
+   ///   Brain float - the upper half of a Float                              
+   ///                                                                        
+   /// A storage type - convert it to Float for arithmetic. Has the range of  
+   /// a Float, but only 8 bits of precision, which suits weights and other   
+   /// data that tolerates the loss. Use ToBFloat16 and ToFloat for arrays    
+   ///                                                                        
+   struct BFloat16 {
+      static constexpr bool CTTI_POD = true;
+      static constexpr bool CTTI_Nullifiable = true;
+
+      ::std::uint16_t mBits {};
+
+      constexpr BFloat16() noexcept = default;
+      constexpr BFloat16(const BFloat16&) noexcept = default;
+
+      /// Convert a float, rounding to nearest even                           
+      LANGULUS(ALWAYS_INLINED)
+      explicit constexpr BFloat16(const Float value) noexcept
+         : mBits {Inner::F32ToBF16(value)} {}
+
+      /// Create from raw bfloat16 bits                                       
+      NOD() LANGULUS(ALWAYS_INLINED)
+      static constexpr BFloat16 FromBits(const ::std::uint16_t bits) noexcept {
+         BFloat16 result;
+         result.mBits = bits;
+         return result;
+      }
+
+      /// Every bfloat16 is exactly representable as a float                  
+      LANGULUS(ALWAYS_INLINED)
+      constexpr operator Float() const noexcept {
+         return Inner::BF16ToF32(mBits);
+      }
+
+      constexpr BFloat16& operator = (const BFloat16&) noexcept = default;
+   };
+
+   static_assert(sizeof(Half) == 2 and sizeof(BFloat16) == 2,
+      "16-bit floats must be two bytes, so that arrays of them can be "
+      "reinterpreted as binary16/bfloat16 data");
+
+   namespace Inner
+   {
+
+      inline void ToHalfScalar(const Float* input, Half* output, const Count count) noexcept {
+         for (Offset i = 0; i < count; ++i)
+            output[i] = Half {input[i]};
+      }
+
+      inline void HalfToFloatScalar(const Half* input, Float* output, const Count count) noexcept {
+         for (Offset i = 0; i < count; ++i)
+            output[i] = input[i];
+      }
+
+      inline void ToBFloat16Scalar(const Float* input, BFloat16* output, const Count count) noexcept {
+         for (Offset i = 0; i < count; ++i)
+            output[i] = BFloat16 {input[i]};
+      }
+
+      inline void BFloat16ToFloatScalar(const BFloat16* input, Float* output, const Count count) noexcept {
+         for (Offset i = 0; i < count; ++i)
+            output[i] = input[i];
+      }
+
+   #if LANGULUS_ARCH(X86)
+      ///                                                                     
+      /// F16C does both directions of half-precision in hardware             
+      ///                                                                     
+      LANGULUS_TARGET(AVX2)
+      inline void ToHalfAVX2(const Float* input, Half* output, const Count count) noexcept {
+         Offset i = 0;
+         for (; i + 8 <= count; i += 8) {
+            const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(input + i),
+               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), h);
+         }
+         ToHalfScalar(input + i, output + i, count - i);
+      }
+
+      LANGULUS_TARGET(AVX512)
+      inline void ToHalfAVX512(const Float* input, Half* output, const Count count) noexcept {
+         Offset i = 0;
+         for (; i + 16 <= count; i += 16) {
+            // Zero-masked with a full mask, because the unmasked one   
+            // trips -Wmaybe-uninitialized in GCC's own headers, and    
+            // compiles to the same instruction                         
+            const __m256i h = _mm512_maskz_cvtps_ph(static_cast<__mmask16>(-1),
+               _mm512_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), h);
+         }
+         ToHalfAVX2(input + i, output + i, count - i);
+      }
+
+      LANGULUS_TARGET(AVX2)
+      inline void HalfToFloatAVX2(const Half* input, Float* output, const Count count) noexcept {
+         Offset i = 0;
+         for (; i + 8 <= count; i += 8) {
+            const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            _mm256_storeu_ps(output + i, _mm256_cvtph_ps(h));
+         }
+         HalfToFloatScalar(input + i, output + i, count - i);
+      }
+
+      LANGULUS_TARGET(AVX512)
+      inline void HalfToFloatAVX512(const Half* input, Float* output, const Count count) noexcept {
+         Offset i = 0;
+         for (; i + 16 <= count; i += 16) {
+            const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+            // Zero-masked with a full mask, as in ToHalfAVX512         
+            _mm512_storeu_ps(output + i, _mm512_maskz_cvtph_ps(static_cast<__mmask16>(-1), h));
+         }
+         HalfToFloatAVX2(input + i, output + i, count - i);
+      }
+
+      ///                                                                     
+      /// Bfloat16 is done with integer ops, as in F32ToBF16 - the native     
+      /// AVX512-BF16 conversions are not part of any of our ISA levels       
+      ///                                                                     
+      /// Round four floats to bfloat16, in the upper halves of the lanes     
+      LANGULUS_TARGET(SSE2) LANGULUS(ALWAYS_INLINED)
+      __m128i RoundToBFloat16SSE2(const __m128i x) noexcept {
+         const __m128i lsb = _mm_and_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(1));
+         const __m128i rounded = _mm_add_epi32(x, _mm_add_epi32(lsb, _mm_set1_epi32(0x7FFF)));
+         const __m128i quiet = _mm_or_si128(x, _mm_set1_epi32(0x400000));
+         const __m128i nan = _mm_cmpgt_epi32(
+            _mm_and_si128(x, _mm_set1_epi32(0x7FFFFFFF)), _mm_set1_epi32(0x7F800000));
+         return _mm_or_si128(_mm_and_si128(nan, quiet), _mm_andnot_si128(nan, rounded));
+      }
+
+      LANGULUS_TARGET(SSE2)
+      inline void ToBFloat16SSE2(const Float* input, BFloat16* output, const Count count) noexcept {
+         Offset i = 0;
+         for (; i + 8 <= count; i += 8) {
+            // Arithmetic shift keeps the upper halves in int16 range,  
+            // so that signed saturation packs them unchanged           
+            const __m128i lo = _mm_srai_epi32(RoundToBFloat16SSE2(
+               _mm_castps_si128(_mm_loadu_ps(input + i))), 16);
+            const __m128i hi = _mm_srai_epi32(RoundToBFloat16SSE2(
+               _mm_castps_si128(_mm_loadu_ps(input + i + 4))), 16);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(lo, hi));
+         }
+         ToBFloat16Scalar(input + i, output + i, count - i);
+      }
+
+      /// Round eight floats to bfloat16, in the upper halves of the lanes    
+      LANGULUS_TARGET(AVX2) LANGULUS(ALWAYS_INLINED)
+      __m256i RoundToBFloat16AVX2(const __m256i x) noexcept {
+         const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1));
+         const __m256i rounded = _mm256_add_epi32(x, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7FFF)));
+         const __m256i quiet = _mm256_or_si256(x, _mm256_set1_epi32(0x400000));
+         const __m256i nan = _mm256_cmpgt_epi32(
+            _mm256_and_si256(x, _mm256_set1_epi32(0x7FFFFFFF)), _mm256_set1_epi32(0x7F800000));
+         return _mm256_blendv_epi8(rounded, quiet, nan);
+      }
+
+      LANGULUS_TARGET(AVX2)
+      inline void ToBFloat16AVX2(const Float* input, BFloat16* output, const Count count) noexcept {
+         Offset i = 0;
+         for (; i + 16 <= count; i += 16) {
+            const __m256i lo = _mm256_srli_epi32(RoundToBFloat16AVX2(
+               _mm256_castps_si256(_mm256_loadu_ps(input + i))), 16);
+            const __m256i hi = _mm256_srli_epi32(RoundToBFloat16AVX2(
+               _mm256_castps_si256(_mm256_loadu_ps(input + i + 8))), 16);
+            // Packing works within 128-bit lanes, so put them in order 
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), packed);
+         }
+         ToBFloat16SSE2(input + i, output + i, count - i);
+      }
+
+      LANGULUS_TARGET(AVX512)
+      inline void ToBFloat16AVX512(const Float* input, BFloat16* output, const Count count) noexcept {
+         Offset i = 0;
+         for (; i + 16 <= count; i += 16) {
+            // Shifts and narrowing are zero-masked with a full mask,   
+            // for the same reason as in ToHalfAVX512                   
+            constexpr auto all = static_cast<__mmask16>(-1);
+            const __m512i x = _mm512_castps_si512(_mm512_loadu_ps(input + i));
+            const __m512i lsb = _mm512_and_si512(_mm512_maskz_srli_epi32(all, x, 16), _mm512_set1_epi32(1));
+            const __m512i rounded = _mm512_add_epi32(x, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7FFF)));
+            const __m512i quiet = _mm512_or_si512(x, _mm512_set1_epi32(0x400000));
+            const __mmask16 nan = _mm512_cmpgt_epi32_mask(
+               _mm512_and_si512(x, _mm512_set1_epi32(0x7FFFFFFF)), _mm512_set1_epi32(0x7F800000));
+            const __m512i result = _mm512_maskz_srli_epi32(all, _mm512_mask_blend_epi32(nan, rounded, quiet), 16);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm512_maskz_cvtepi32_epi16(all, result));
+         }
+         ToBFloat16AVX2(input + i, output + i, count - i);
+      }
+
+      LANGULUS_TARGET(SSE2)
+      inline void BFloat16ToFloatSSE2(const BFloat16* input, Float* output, const Count count) noexcept {
+         const __m128i zero = _mm_setzero_si128();
+         Offset i = 0;
+         for (; i + 8 <= count; i += 8) {
+            // Interleaving with zeroes puts each one in an upper half  
+            const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            _mm_storeu_ps(output + i,     _mm_castsi128_ps(_mm_unpacklo_epi16(zero, h)));
+            _mm_storeu_ps(output + i + 4, _mm_castsi128_ps(_mm_unpackhi_epi16(zero, h)));
+         }
+         BFloat16ToFloatScalar(input + i, output + i, count - i);
+      }
+
+      LANGULUS_TARGET(AVX2)
+      inline void BFloat16ToFloatAVX2(const BFloat16* input, Float* output, const Count count) noexcept {
+         Offset i = 0;
+         for (; i + 8 <= count; i += 8) {
+            const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            const __m256i x = _mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16);
+            _mm256_storeu_ps(output + i, _mm256_castsi256_ps(x));
+         }
+         BFloat16ToFloatScalar(input + i, output + i, count - i);
+      }
+
+      LANGULUS_TARGET(AVX512)
+      inline void BFloat16ToFloatAVX512(const BFloat16* input, Float* output, const Count count) noexcept {
+         Offset i = 0;
+         for (; i + 16 <= count; i += 16) {
+            // Zero-masked with a full mask, as in ToHalfAVX512         
+            constexpr auto all = static_cast<__mmask16>(-1);
+            const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+            const __m512i x = _mm512_maskz_slli_epi32(all, _mm512_maskz_cvtepu16_epi32(all, h), 16);
+            _mm512_storeu_ps(output + i, _mm512_castsi512_ps(x));
+         }
+         BFloat16ToFloatAVX2(input + i, output + i, count - i);
+      }
+
+      constexpr Multiversion<&ToHalfScalar, nullptr, &ToHalfAVX2, &ToHalfAVX512> ToHalfKernel;
+      constexpr Multiversion<&HalfToFloatScalar, nullptr, &HalfToFloatAVX2, &HalfToFloatAVX512> HalfToFloatKernel;
+      constexpr Multiversion<&ToBFloat16Scalar, &ToBFloat16SSE2, &ToBFloat16AVX2, &ToBFloat16AVX512> ToBFloat16Kernel;
+      constexpr Multiversion<&BFloat16ToFloatScalar, &BFloat16ToFloatSSE2, &BFloat16ToFloatAVX2, &BFloat16ToFloatAVX512> BFloat16ToFloatKernel;
+   #else
+      constexpr Multiversion<&ToHalfScalar> ToHalfKernel;
+      constexpr Multiversion<&HalfToFloatScalar> HalfToFloatKernel;
+      constexpr Multiversion<&ToBFloat16Scalar> ToBFloat16Kernel;
+      constexpr Multiversion<&BFloat16ToFloatScalar> BFloat16ToFloatKernel;
+   #endif
+
+   } // namespace Langulus::Inner
+
+
+   /// Convert floats to half-precision, rounding to nearest even             
+   /// Uses F16C or AVX-512 if the host has them, picked on first call        
+   ///   @param input - the floats                                            
+   ///   @param output - where to write the halves                            
+   ///   @param count - number of elements                                    
+   LANGULUS(INLINED)
+   void ToHalf(const Float* input, Half* output, const Count count) noexcept {
+      Inner::ToHalfKernel(input, output, count);
+   }
+
+   /// Convert floats to bfloat16, rounding to nearest even                   
+   /// Uses SSE2, AVX2 or AVX-512 if the host has them, picked on first call  
+   ///   @param input - the floats                                            
+   ///   @param output - where to write the bfloat16s                         
+   ///   @param count - number of elements                                    
+   LANGULUS(INLINED)
+   void ToBFloat16(const Float* input, BFloat16* output, const Count count) noexcept {
+      Inner::ToBFloat16Kernel(input, output, count);
+   }
+
+   /// Convert half-precision floats to floats, which is exact                
+   /// Uses F16C or AVX-512 if the host has them, picked on first call        
+   ///   @param input - the halves                                            
+   ///   @param output - where to write the floats                            
+   ///   @param count - number of elements                                    
+   LANGULUS(INLINED)
+   void ToFloat(const Half* input, Float* output, const Count count) noexcept {
+      Inner::HalfToFloatKernel(input, output, count);
+   }
+
+   /// Convert bfloat16s to floats, which is exact                            
+   /// Uses SSE2, AVX2 or AVX-512 if the host has them, picked on first call  
+   ///   @param input - the bfloat16s                                         
+   ///   @param output - where to write the floats                            
+   ///   @param count - number of elements                                    
+   LANGULUS(INLINED)
+   void ToFloat(const BFloat16* input, Float* output, const Count count) noexcept {
+      Inner::BFloat16ToFloatKernel(input, output, count);
+   }
+
+} // namespace Langulus
@@ -0,0 +1,456 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Utilities.hpp"
+#include <array>
+#include <tuple>
+
+#if LANGULUS_SIMD(AVX2)
+   #include <immintrin.h>
+#elif LANGULUS_SIMD(SSE2)
+   #include <emmintrin.h>
+#endif
+
+
+namespace Langulus
+{
+   namespace CT
+   {
+      /// Check if all T are one-byte types, that can be hashed at compile-   
+      /// time, as well as at runtime                                         
+      template<class...T>
+      concept HashableByte = sizeof...(T) > 0 and ((sizeof(T) == 1
+          and (BuiltinCharacter<T> or SimilarAsOneOf<T, ::std::byte, unsigned char, signed char>)
+         ) and ...);
+   }
+
+   namespace Inner
+   {
+
+      /// Hashing constants, borrowed from wyhash                             
+      constexpr ::std::uint64_t HashP0 = 0xa0761d6478bd642full;
+      constexpr ::std::uint64_t HashP1 = 0xe7037ed1a0b428dbull;
+      constexpr ::std::uint64_t HashP2 = 0x8ebc6af09c88c6e3ull;
+      constexpr ::std::uint64_t HashP3 = 0x589965cc75374cc3ull;
+      constexpr ::std::uint64_t HashPrime32 = 0x9E3779B1ull;
+
+      /// Inputs of this size or bigger are hashed in 64-byte stripes, with   
+      /// eight independent accumulators, which is where SIMD kicks in        
+      constexpr Count HashStripeThreshold = 256;
+      constexpr Count HashStripe = 64;
+
+      /// Key material for the striped path, generated via splitmix64         
+      /// Each stripe uses an 8-word window, sliding one word per stripe      
+      constexpr auto HashSecret = []() {
+         ::std::array<::std::uint64_t, 24> result {};
+         ::std::uint64_t state = HashP0;
+         for (auto& word : result) {
+            state += 0x9E3779B97F4A7C15ull;
+            auto z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+         }
+         return result;
+      }();
+
+      /// Multiply two words and fold the 128-bit product                     
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr ::std::uint64_t HashMix(
+         const ::std::uint64_t a, const ::std::uint64_t b
+      ) noexcept {
+         ::std::uint64_t high;
+         const auto low = MultiplyWide(a, b, high);
+         return low ^ high;
+      }
+
+      /// Final bit avalanche, borrowed from XXH3                             
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr ::std::uint64_t HashAvalanche(::std::uint64_t h) noexcept {
+         h ^= h >> 37;
+         h *= 0x165667919E3779F9ull;
+         return h ^ (h >> 32);
+      }
+
+      /// Read a little-endian unsigned integer from a byte sequence          
+      /// Done byte by byte at compile-time, and via memcpy at runtime        
+      template<CT::Unsigned T, CT::HashableByte B> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr T HashRead(const B* p) noexcept {
+         IF_CONSTEXPR() {
+            T result {};
+            for (unsigned i = 0; i < sizeof(T); ++i)
+               result |= static_cast<T>(static_cast<unsigned char>(p[i])) << (i * 8);
+            return result;
+         }
+         else {
+            T result;
+            ::std::memcpy(&result, p, sizeof(T));
+            if constexpr (BigEndianMachine)
+               result = ::std::byteswap(result);
+            return result;
+         }
+      }
+
+      /// Accumulate a single 64-byte stripe, portable version                
+      ///   @param acc - the eight accumulators                               
+      ///   @param p - the stripe                                             
+      ///   @param key - the eight key words for this stripe                  
+      template<CT::HashableByte B> LANGULUS(ALWAYS_INLINED)
+      constexpr void HashAccumulate(
+         ::std::uint64_t* acc, const B* p, const ::std::uint64_t* key
+      ) noexcept {
+         for (int i = 0; i < 8; ++i) {
+            const auto data = HashRead<::std::uint64_t>(p + i * 8);
+            const auto keyed = data ^ key[i];
+            acc[i ^ 1] += data;
+            acc[i] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+         }
+      }
+
+      /// Scramble the accumulators, portable version                         
+      ///   @param acc - the eight accumulators                               
+      ///   @param key - the eight key words                                  
+      LANGULUS(ALWAYS_INLINED)
+      constexpr void HashScramble(
+         ::std::uint64_t* acc, const ::std::uint64_t* key
+      ) noexcept {
+         for (int i = 0; i < 8; ++i) {
+            auto a = acc[i];
+            a ^= a >> 47;
+            a ^= key[i];
+            acc[i] = a * HashPrime32;
+         }
+      }
+
+      /// Process all full stripes, except the last one, portable version     
+      template<CT::HashableByte B>
+      constexpr void HashStripes(
+         ::std::uint64_t* acc, const B* p, const Count stripes
+      ) noexcept {
+         for (Count n = 0; n < stripes; ++n) {
+            HashAccumulate(acc, p + n * HashStripe, HashSecret.data() + (n % 16));
+            if (n % 16 == 15)
+               HashScramble(acc, HashSecret.data() + 16);
+         }
+      }
+
+   #if LANGULUS_SIMD(AVX2)
+      /// Process all full stripes, except the last one, AVX2 version         
+      /// Produces the exact same results as the portable version             
+      inline void HashStripesSIMD(
+         ::std::uint64_t* acc, const void* data, const Count stripes
+      ) noexcept {
+         auto p = static_cast<const __m256i*>(data);
+         auto accPtr = reinterpret_cast<__m256i*>(acc);
+         __m256i a0 = _mm256_loadu_si256(accPtr + 0);
+         __m256i a1 = _mm256_loadu_si256(accPtr + 1);
+         const __m256i prime = _mm256_set1_epi32(static_cast<int>(HashPrime32));
+
+         const auto accumulate = [](__m256i a, __m256i d, __m256i k) noexcept {
+            const __m256i keyed = _mm256_xor_si256(d, k);
+            const __m256i hi = _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m256i product = _mm256_mul_epu32(keyed, hi);
+            const __m256i swapped = _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+            return _mm256_add_epi64(a, _mm256_add_epi64(product, swapped));
+         };
+
+         const auto scramble = [&prime](__m256i a, __m256i k) noexcept {
+            a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+            a = _mm256_xor_si256(a, k);
+            const __m256i lo = _mm256_mul_epu32(a, prime);
+            const __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+            return _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+         };
+
+         const auto k = HashSecret.data();
+         for (Count n = 0; n < stripes; ++n, p += 2) {
+            const auto w = reinterpret_cast<const __m256i*>(k + (n % 16));
+            a0 = accumulate(a0, _mm256_loadu_si256(p + 0), _mm256_loadu_si256(w + 0));
+            a1 = accumulate(a1, _mm256_loadu_si256(p + 1), _mm256_loadu_si256(w + 1));
+
+            if (n % 16 == 15) {
+               const auto s = reinterpret_cast<const __m256i*>(k + 16);
+               a0 = scramble(a0, _mm256_loadu_si256(s + 0));
+               a1 = scramble(a1, _mm256_loadu_si256(s + 1));
+            }
+         }
+
+         _mm256_storeu_si256(accPtr + 0, a0);
+         _mm256_storeu_si256(accPtr + 1, a1);
+      }
+   #elif LANGULUS_SIMD(SSE2)
+      /// Process all full stripes, except the last one, SSE2 version         
+      /// Produces the exact same results as the portable version             
+      inline void HashStripesSIMD(
+         ::std::uint64_t* acc, const void* data, const Count stripes
+      ) noexcept {
+         auto p = static_cast<const __m128i*>(data);
+         auto accPtr = reinterpret_cast<__m128i*>(acc);
+         __m128i a[4];
+         for (int i = 0; i < 4; ++i)
+            a[i] = _mm_loadu_si128(accPtr + i);
+         const __m128i prime = _mm_set1_epi32(static_cast<int>(HashPrime32));
+
+         for (Count n = 0; n < stripes; ++n, p += 4) {
+            const auto w = reinterpret_cast<const __m128i*>(HashSecret.data() + (n % 16));
+            for (int i = 0; i < 4; ++i) {
+               const __m128i d = _mm_loadu_si128(p + i);
+               const __m128i keyed = _mm_xor_si128(d, _mm_loadu_si128(w + i));
+               const __m128i hi = _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1));
+               const __m128i product = _mm_mul_epu32(keyed, hi);
+               const __m128i swapped = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+               a[i] = _mm_add_epi64(a[i], _mm_add_epi64(product, swapped));
+            }
+
+            if (n % 16 == 15) {
+               const auto s = reinterpret_cast<const __m128i*>(HashSecret.data() + 16);
+               for (int i = 0; i < 4; ++i) {
+                  __m128i x = _mm_xor_si128(a[i], _mm_srli_epi64(a[i], 47));
+                  x = _mm_xor_si128(x, _mm_loadu_si128(s + i));
+                  const __m128i lo = _mm_mul_epu32(x, prime);
+                  const __m128i hi = _mm_mul_epu32(_mm_srli_epi64(x, 32), prime);
+                  a[i] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+               }
+            }
+         }
+
+         for (int i = 0; i < 4; ++i)
+            _mm_storeu_si128(accPtr + i, a[i]);
+      }
+   #endif
+
+      /// Hash big inputs via striped accumulation                            
+      ///   @param p - the data to hash                                       
+      ///   @param len - number of bytes, at least HashStripeThreshold        
+      ///   @param seed - the prepared seed                                   
+      ///   @return the hash                                                  
+      template<CT::HashableByte B> NOD()
+      constexpr ::std::uint64_t HashLong(
+         const B* p, const Count len, const ::std::uint64_t seed
+      ) noexcept {
+         ::std::uint64_t acc[8];
+         for (int i = 0; i < 8; ++i)
+            acc[i] = HashSecret[i] ^ seed;
+
+         const Count stripes = (len - 1) / HashStripe;
+         IF_CONSTEXPR() {
+            HashStripes(acc, p, stripes);
+         }
+         else {
+         #if LANGULUS_SIMD(AVX2) or LANGULUS_SIMD(SSE2)
+            if constexpr (LittleEndianMachine)
+               HashStripesSIMD(acc, p, stripes);
+            else
+               HashStripes(acc, p, stripes);
+         #else
+            HashStripes(acc, p, stripes);
+         #endif
+         }
+
+         // The last stripe always overlaps, so that no tail is left    
+         HashAccumulate(acc, p + len - HashStripe, HashSecret.data() + 13);
+
+         auto result = (len * HashP0) ^ seed;
+         for (int i = 0; i < 4; ++i) {
+            result += HashMix(
+               acc[i * 2 + 0] ^ HashSecret[8 + i * 2],
+               acc[i * 2 + 1] ^ HashSecret[9 + i * 2]
+            );
+         }
+         return HashAvalanche(result);
+      }
+
+      /// Hash a number in a single multiplication                            
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr Hash HashNumber(const ::std::uint64_t n) noexcept {
+         return static_cast<::std::size_t>(HashMix(n ^ HashP0, HashP1 ^ HashP3));
+      }
+
+      /// Combine two hashes in an order-dependent way                        
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr Hash HashCombine(const Hash& lhs, const Hash& rhs) noexcept {
+         return static_cast<::std::size_t>(HashMix(
+            static_cast<::std::uint64_t>(lhs.mHash) ^ HashP2,
+            static_cast<::std::uint64_t>(rhs.mHash) ^ HashP3
+         ));
+      }
+
+   } // namespace Langulus::Inner
+
+
+   /// Hash a sequence of bytes                                               
+   /// Uses a wyhash-like mixer for small inputs, and an XXH3-like striped    
+   /// accumulator for big ones, with SSE2/AVX2 versions when available.      
+   /// Results are identical at compile-time and at runtime, regardless of    
+   /// the enabled instruction sets                                           
+   ///   @param data - the bytes to hash                                      
+   ///   @param count - number of bytes                                       
+   ///   @param seed - optional seed                                          
+   ///   @return the hash                                                     
+   template<CT::HashableByte B> NOD()
+   constexpr Hash HashBytes(
+      const B* data, const Count count, const ::std::uint64_t seed = 0
+   ) noexcept {
+      using namespace Inner;
+      auto s = seed ^ HashMix(seed ^ HashP0, HashP1);
+      if (count >= HashStripeThreshold)
+         return static_cast<::std::size_t>(HashLong(data, count, s));
+
+      ::std::uint64_t a = 0, b = 0;
+      if (count <= 16) LIKELY() {
+         if (count >= 4) {
+            const Count shift = (count >> 3) << 2;
+            a = (static_cast<::std::uint64_t>(HashRead<::std::uint32_t>(data)) << 32)
+               | HashRead<::std::uint32_t>(data + shift);
+            b = (static_cast<::std::uint64_t>(HashRead<::std::uint32_t>(data + count - 4)) << 32)
+               | HashRead<::std::uint32_t>(data + count - 4 - shift);
+         }
+         else if (count > 0) {
+            a = (static_cast<::std::uint64_t>(static_cast<unsigned char>(data[0])) << 16)
+               | (static_cast<::std::uint64_t>(static_cast<unsigned char>(data[count >> 1])) << 8)
+               |  static_cast<::std::uint64_t>(static_cast<unsigned char>(data[count - 1]));
+         }
+      }
+      else {
+         auto p = data;
+         auto left = count;
+         while (left > 16) {
+            s = HashMix(
+               HashRead<::std::uint64_t>(p + 0) ^ HashP1,
+               HashRead<::std::uint64_t>(p + 8) ^ s
+            );
+            p += 16;
+            left -= 16;
+         }
+
+         a = HashRead<::std::uint64_t>(data + count - 16);
+         b = HashRead<::std::uint64_t>(data + count - 8);
+      }
+
+      ::std::uint64_t high;
+      const auto low = MultiplyWide(a ^ HashP1, b ^ s, high);
+      return static_cast<::std::size_t>(HashMix(low ^ HashP0 ^ count, high ^ HashP1));
+   }
+
+   /// Hash a sequence of bytes, runtime version for arbitrary memory         
+   ///   @param data - the bytes to hash                                      
+   ///   @param count - number of bytes                                       
+   ///   @param seed - optional seed                                          
+   ///   @return the hash                                                     
+   NOD() LANGULUS(INLINED)
+   Hash HashBytes(
+      const void* data, const Count count, const ::std::uint64_t seed = 0
+   ) noexcept {
+      return HashBytes(static_cast<const ::std::byte*>(data), count, seed);
+   }
+
+   template<class T> NOD()
+   constexpr Hash HashOf(const T&);
+
+   template<class T1, class T2, class...TN> NOD()
+   constexpr Hash HashOf(const T1&, const T2&, const TN&...);
+
+   /// Hash a contiguous sequence of elements                                 
+   /// Character spans are hashed at compile-time, as well as at runtime;     
+   /// any other plain-old-data (see CT::Inner::POD) is hashed in bulk as raw 
+   /// bytes; anything else is hashed element by element, and combined        
+   ///   @attention bulk hashing is bitwise, so -0.0 and 0.0 will differ,     
+   ///      unlike when hashing a single real number via HashOf               
+   ///   @param data - the first element                                      
+   ///   @param count - number of elements                                    
+   ///   @return the hash                                                     
+   template<class T> NOD()
+   constexpr Hash HashData(const T* data, const Count count) {
+      if constexpr (CT::HashableByte<T>)
+         return HashBytes(data, count);
+      else if constexpr (CT::Inner::POD<T> and not CT::Sparse<T>) {
+         IF_CONSTEXPR() {
+            // Can't reinterpret memory at compile-time                 
+            Hash result = Inner::HashNumber(count);
+            for (Count i = 0; i < count; ++i)
+               result = Inner::HashCombine(result, HashOf(data[i]));
+            return result;
+         }
+         else return HashBytes(static_cast<const void*>(data), count * sizeof(T));
+      }
+      else {
+         Hash result = Inner::HashNumber(count);
+         for (Count i = 0; i < count; ++i)
+            result = Inner::HashCombine(result, HashOf(data[i]));
+         return result;
+      }
+   }
+
+   /// Hash a single item                                                     
+   /// - Hash is returned as it is                                            
+   /// - types with a GetHash() method use it                                 
+   /// - numbers, enums, characters and pointers are mixed in one multiply    
+   /// - strings and contiguous containers are hashed via HashData            
+   /// - tuples, pairs and other tuple-likes are combined in order            
+   /// - other plain-old-data is hashed bytewise                              
+   ///   @param item - the item to hash                                       
+   ///   @return the hash                                                     
+   template<class T> NOD()
+   constexpr Hash HashOf(const T& item) {
+      using D = Decvq<Deref<T>>;
+
+      if constexpr (::std::same_as<D, Hash>)
+         return item;
+      else if constexpr (requires { {item.GetHash()} -> CT::Exact<Hash>; })
+         return item.GetHash();
+      else if constexpr (CT::String<D>)
+         return HashOf(Token {item});
+      else if constexpr (CT::Sparse<D>)
+         return Inner::HashNumber(reinterpret_cast<Pointer>(item));
+      else if constexpr (CT::Enum<D>)
+         return Inner::HashNumber(static_cast<::std::uint64_t>(
+            static_cast<::std::underlying_type_t<D>>(item)));
+      else if constexpr (::std::integral<D>)
+         return Inner::HashNumber(static_cast<::std::uint64_t>(item));
+      else if constexpr (CT::BuiltinReal<D>) {
+         // Make sure -0.0 and 0.0 are hashed the same, since equal     
+         if (item == D {0})
+            return Inner::HashNumber(0);
+
+         if constexpr (sizeof(D) == 4)
+            return Inner::HashNumber(::std::bit_cast<::std::uint32_t>(item));
+         else if constexpr (sizeof(D) == 8)
+            return Inner::HashNumber(::std::bit_cast<::std::uint64_t>(item));
+         else
+            return HashBytes(static_cast<const void*>(&item), sizeof(D));
+      }
+      else if constexpr (CT::StdContiguousContainer<D>)
+         return HashData(item.data(), item.size());
+      else if constexpr (requires { ::std::tuple_size<D>::value; }) {
+         return ::std::apply([](const auto&...elements) {
+            if constexpr (sizeof...(elements) == 0)
+               return Inner::HashNumber(0);
+            else
+               return HashOf(elements...);
+         }, item);
+      }
+      else if constexpr (CT::Inner::POD<D>)
+         return HashBytes(static_cast<const void*>(&item), sizeof(D));
+      else
+         static_assert(false, "Type is not hashable");
+   }
+
+   /// Hash multiple items, and combine the hashes                            
+   /// The combination is order-dependent, so HashOf(a, b) != HashOf(b, a)    
+   ///   @param first - the first item                                        
+   ///   @param second - the second item                                      
+   ///   @param tail - any other items                                        
+   ///   @return the combined hash                                            
+   template<class T1, class T2, class...TN> NOD()
+   constexpr Hash HashOf(const T1& first, const T2& second, const TN&...tail) {
+      auto result = Inner::HashCombine(HashOf(first), HashOf(second));
+      ((result = Inner::HashCombine(result, HashOf(tail))), ...);
+      return result;
+   }
+
+} // namespace Langulus
@@ -0,0 +1,620 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Pool.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#if LANGULUS_OS(WINDOWS)
+   // Declared manually, because windows.h pollutes everything with macros
+   extern "C" __declspec(dllimport) unsigned short __stdcall RtlCaptureStackBackTrace(unsigned long, unsigned long, void**, unsigned long*);
+#elif LANGULUS_COMPILER(GCC) or LANGULUS_COMPILER(CLANG)
+   #include <unwind.h>
+#endif
+
+
+namespace Langulus
+{
+
+   namespace Inner
+   {
+
+      /// Maximum number of stack frames in a sample                          
+      constexpr Count ProfilerDepth = 32;
+      /// Maximum number of samples - when full, samples of deallocated       
+      /// memory are recycled, and if there are none, new samples are dropped 
+      constexpr Count ProfilerCapacity = 8192;
+      /// Threads check whether the profiler was started after allocating     
+      /// that many bytes                                                     
+      constexpr Offset ProfilerIdleCountdown = 64_MiB;
+      /// Marks a removed entry in the address table                          
+      inline void* const ProfilerTombstone = reinterpret_cast<void*>(Pointer {1});
+
+      ///                                                                     
+      /// A single sampled allocation                                         
+      ///                                                                     
+      struct ProfilerSample {
+         // The allocation, or nullptr after it was deallocated         
+         ::std::atomic<void*> mAddress;
+         // Size of the allocation                                      
+         Offset mSize;
+         // The sampling period at the time of sampling                 
+         Offset mPeriod;
+         // Optional call site tag, like LANGULUS_LOCATION(), must be a 
+         // literal, or otherwise outlive the profiler                  
+         Token mTag;
+         // Return addresses, innermost first                           
+         Count mDepth;
+         void* mFrames[ProfilerDepth];
+         // Odd while the sample is being written, zero if never written
+         ::std::atomic<::std::uint32_t> mVersion;
+         // The next sample in the list of recyclable samples           
+         ::std::uint32_t mNextFree;
+      };
+
+      /// An entry in the table of sampled addresses                          
+      struct ProfilerKey {
+         ::std::atomic<void*> mAddress;
+         Count mSample;
+      };
+
+      ///                                                                     
+      /// Profiler state, shared between all threads                          
+      ///                                                                     
+      struct ProfilerState {
+         ::std::atomic<bool> mActive;
+         // Mean number of bytes between samples                        
+         ::std::atomic<Offset> mPeriod;
+         // Number of samples taken, and dropped, because capacity was hit
+         ::std::atomic<Count> mCount;
+         ::std::atomic<Count> mDropped;
+         // Number of samples that weren't yet deallocated              
+         ::std::atomic<Count> mLive;
+         // Samples of deallocated memory, that can be recycled - the low
+         // half is the index + 1, the high half counts pushes, to avoid
+         // the ABA problem                                             
+         ::std::atomic<::std::uint64_t> mFreeSamples;
+         // Sample storage, and a table of sampled addresses, with twice
+         // the capacity, so that it never fills up - both never freed  
+         ProfilerSample* mSamples;
+         ProfilerKey* mKeys;
+         // Protects Start/Stop                                         
+         SpinLock mLock;
+      };
+
+      inline constinit ProfilerState Profiler {};
+
+      /// Bytes left until the current thread takes its next sample           
+      inline constinit thread_local ::std::ptrdiff_t ProfilerCountdown = 0;
+      /// Random state of the current thread                                  
+      inline constinit thread_local ::std::uint64_t ProfilerRandom = 0;
+      /// Tag of the innermost ProfilerTag scope of the current thread        
+      inline constinit thread_local Token ProfilerScopeTag {};
+
+      /// Get the index of an address in the table of sampled addresses,      
+      /// via Fibonacci hashing, which takes the top bits of the product      
+      NOD() LANGULUS(ALWAYS_INLINED)
+      Count ProfilerSlotOf(const void* address) noexcept {
+         constexpr auto bits = CountTrailingZeroes(ProfilerCapacity * 2);
+         const auto key = static_cast<::std::uint64_t>(reinterpret_cast<Pointer>(address));
+         return static_cast<Count>((key * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+      }
+
+      /// Pick the distance to the next sample, so that samples are a         
+      /// Poisson process over allocated bytes - that way, every byte has the 
+      /// same chance to be sampled, regardless of allocation patterns        
+      ///   @param period - mean number of bytes between samples              
+      ///   @return the number of bytes until the next sample                 
+      NOD() LANGULUS(NOINLINE)
+      inline ::std::ptrdiff_t ProfilerDistance(const Offset period) noexcept {
+         auto x = ProfilerRandom;
+         if (not x)
+            x = reinterpret_cast<Pointer>(&ProfilerRandom) | 1;
+         x ^= x >> 12;
+         x ^= x << 25;
+         x ^= x >> 27;
+         ProfilerRandom = x;
+
+         // Uniform in (0, 1], and then exponentially distributed       
+         const auto uniform = static_cast<double>(((x * 0x2545F4914F6CDD1Dull) >> 11) + 1)
+                            * 0x1.0p-53;
+         const auto distance = -::std::log(uniform) * static_cast<double>(period);
+         return static_cast<::std::ptrdiff_t>(distance) + 1;
+      }
+
+   #if not LANGULUS_OS(WINDOWS) and (LANGULUS_COMPILER(GCC) or LANGULUS_COMPILER(CLANG))
+      /// State for walking the stack via the unwinder                        
+      struct ProfilerUnwind {
+         void** mFrames;
+         Count mSkip;
+         Count mDepth;
+      };
+
+      inline _Unwind_Reason_Code ProfilerUnwindFrame(_Unwind_Context* context, void* state) {
+         const auto unwind = static_cast<ProfilerUnwind*>(state);
+         const auto ip = _Unwind_GetIP(context);
+         if (not ip)
+            return _URC_END_OF_STACK;
+         if (unwind->mSkip) {
+            --unwind->mSkip;
+            return _URC_NO_REASON;
+         }
+
+         unwind->mFrames[unwind->mDepth++] = reinterpret_cast<void*>(ip);
+         return unwind->mDepth < ProfilerDepth ? _URC_NO_REASON : _URC_END_OF_STACK;
+      }
+   #endif
+
+      /// Capture the return addresses of the calling thread, without         
+      /// allocating anything                                                 
+      ///   @param frames - [out] where to write the addresses                
+      ///   @param skip - number of innermost frames to skip                  
+      ///   @return the number of captured frames, zero if unsupported        
+      LANGULUS(NOINLINE)
+      inline Count ProfilerCaptureStack(void** frames, const Count skip) noexcept {
+      #if LANGULUS_OS(WINDOWS)
+         return RtlCaptureStackBackTrace(static_cast<unsigned long>(skip + 1),
+            static_cast<unsigned long>(ProfilerDepth), frames, nullptr);
+      #elif LANGULUS_COMPILER(GCC) or LANGULUS_COMPILER(CLANG)
+         ProfilerUnwind unwind {frames, skip + 1, 0};
+         _Unwind_Backtrace(ProfilerUnwindFrame, &unwind);
+         return unwind.mDepth;
+      #else
+         (void) frames;
+         (void) skip;
+         return 0;
+      #endif
+      }
+
+      /// Get a sample to write to - a fresh one, or else the most recently   
+      /// deallocated one                                                     
+      ///   @return the sample index, or ProfilerCapacity if full             
+      NOD() LANGULUS(INLINED)
+      Count ProfilerClaimSample() noexcept {
+         if (Profiler.mCount.load(::std::memory_order_relaxed) < ProfilerCapacity) {
+            const auto index = Profiler.mCount.fetch_add(1, ::std::memory_order_relaxed);
+            if (index < ProfilerCapacity)
+               return index;
+         }
+
+         auto head = Profiler.mFreeSamples.load(::std::memory_order_acquire);
+         while (head & 0xFFFFFFFFull) {
+            const Count index = (head & 0xFFFFFFFFull) - 1;
+            const auto next = (head & ~0xFFFFFFFFull)
+               | Profiler.mSamples[index].mNextFree;
+            if (Profiler.mFreeSamples.compare_exchange_weak(head, next,
+               ::std::memory_order_acquire, ::std::memory_order_acquire))
+               return index;
+         }
+         return ProfilerCapacity;
+      }
+
+      /// Make a sample available for recycling                               
+      LANGULUS(INLINED)
+      void ProfilerRecycleSample(const Count index) noexcept {
+         auto head = Profiler.mFreeSamples.load(::std::memory_order_relaxed);
+         do {
+            Profiler.mSamples[index].mNextFree = static_cast<::std::uint32_t>(head);
+         }
+         while (not Profiler.mFreeSamples.compare_exchange_weak(head,
+            ((head >> 32) + 1) << 32 | (index + 1),
+            ::std::memory_order_release, ::std::memory_order_relaxed));
+      }
+
+      /// Record a sample of an allocation                                    
+      LANGULUS(NOINLINE)
+      inline void ProfilerTakeSample(void* memory, const Offset bytes, const Token& tag) noexcept {
+         if (not Profiler.mActive.load(::std::memory_order_acquire)) {
+            ProfilerCountdown = ProfilerIdleCountdown;
+            return;
+         }
+
+         const auto period = Profiler.mPeriod.load(::std::memory_order_relaxed);
+         ProfilerCountdown = ProfilerDistance(period);
+
+         const auto index = ProfilerClaimSample();
+         if (index == ProfilerCapacity) {
+            Profiler.mDropped.fetch_add(1, ::std::memory_order_relaxed);
+            return;
+         }
+
+         // Dump might be reading the sample, while it is being recycled,
+         // so it is written like a seqlock                             
+         auto& sample = Profiler.mSamples[index];
+         sample.mVersion.fetch_add(1, ::std::memory_order_relaxed);
+         ::std::atomic_thread_fence(::std::memory_order_release);
+         sample.mSize = bytes;
+         sample.mPeriod = period;
+         sample.mTag = tag.empty() ? ProfilerScopeTag : tag;
+         // Skip this function, and the allocator that sampled          
+         sample.mDepth = ProfilerCaptureStack(sample.mFrames, 2);
+         sample.mAddress.store(memory, ::std::memory_order_relaxed);
+
+         sample.mVersion.fetch_add(1, ::std::memory_order_release);
+
+         // Register the address, so that deallocations can find it. The
+         // same address tends to be sampled over and over, so tombstones
+         // are reused, or they would pile up into long probe sequences 
+         auto slot = ProfilerSlotOf(memory);
+         while (true) {
+            auto& key = Profiler.mKeys[slot];
+            auto address = key.mAddress.load(::std::memory_order_relaxed);
+            if ((address == nullptr or address == ProfilerTombstone)
+            and key.mAddress.compare_exchange_strong(address, memory,
+               ::std::memory_order_release, ::std::memory_order_relaxed)) {
+               key.mSample = index;
+               break;
+            }
+            slot = (slot + 1) & (ProfilerCapacity * 2 - 1);
+         }
+
+         Profiler.mLive.fetch_add(1, ::std::memory_order_relaxed);
+      }
+
+      /// Forget a sampled allocation, after it was deallocated               
+      LANGULUS(NOINLINE)
+      inline void ProfilerForget(void* memory) noexcept {
+         auto slot = ProfilerSlotOf(memory);
+         while (true) {
+            auto& key = Profiler.mKeys[slot];
+            auto address = key.mAddress.load(::std::memory_order_acquire);
+            if (not address)
+               return;
+
+            // Only the deallocating thread can remove its address, so  
+            // there is no need to compare-exchange                     
+            if (address == memory) {
+               const auto index = key.mSample;
+               key.mAddress.store(ProfilerTombstone, ::std::memory_order_relaxed);
+               Profiler.mSamples[index].mAddress.store(nullptr, ::std::memory_order_relaxed);
+               Profiler.mLive.fetch_sub(1, ::std::memory_order_relaxed);
+               ProfilerRecycleSample(index);
+               return;
+            }
+            slot = (slot + 1) & (ProfilerCapacity * 2 - 1);
+         }
+      }
+
+      /// Account for an allocation, and sample it if its turn has come       
+      /// Costs a thread-local subtraction, unless the allocation is sampled  
+      ///   @param memory - the allocation                                    
+      ///   @param bytes - the size of the allocation                         
+      ///   @param tag - optional call site tag, like LANGULUS_LOCATION(),    
+      ///                the tag of the current ProfilerTag scope if empty    
+      LANGULUS(ALWAYS_INLINED)
+      void SampleAllocation(void* memory, const Offset bytes, const Token& tag = {}) noexcept {
+         ProfilerCountdown -= static_cast<::std::ptrdiff_t>(bytes);
+         if (ProfilerCountdown < 0) UNLIKELY()
+            ProfilerTakeSample(memory, bytes, tag);
+      }
+
+      /// Account for a deallocation, in case the allocation was sampled      
+      ///   @param memory - the allocation                                    
+      LANGULUS(ALWAYS_INLINED)
+      void SampleDeallocation(void* memory) noexcept {
+         if (Profiler.mLive.load(::std::memory_order_relaxed)) UNLIKELY()
+            ProfilerForget(memory);
+      }
+
+      ///                                                                     
+      /// Minimal protocol buffer writer, enough for a pprof profile          
+      ///                                                                     
+      struct ProfileWriter {
+         ::std::string mBuffer;
+
+         void Varint(::std::uint64_t value) {
+            while (value >= 0x80) {
+               mBuffer += static_cast<char>((value & 0x7F) | 0x80);
+               value >>= 7;
+            }
+            mBuffer += static_cast<char>(value);
+         }
+
+         void Number(const unsigned field, const ::std::uint64_t value) {
+            Varint(field << 3);
+            Varint(value);
+         }
+
+         void Bytes(const unsigned field, const Token& value) {
+            Varint((field << 3) | 2);
+            Varint(value.size());
+            mBuffer.append(value.data(), value.size());
+         }
+
+         void Packed(const unsigned field, const ::std::uint64_t* values, const Count count) {
+            ProfileWriter packed;
+            for (Count i = 0; i < count; ++i)
+               packed.Varint(values[i]);
+            Bytes(field, packed.mBuffer);
+         }
+      };
+
+   } // namespace Langulus::Inner
+
+
+   ///                                                                        
+   ///   Sampling heap profiler                                               
+   ///                                                                        
+   /// Samples roughly one allocation for every period bytes allocated, along 
+   /// with its call stack, or call site tag, and whether it was deallocated  
+   /// since. Sampling is unbiased, so multiplying the samples by the         
+   /// probability of being sampled gives a good estimate of which call       
+   /// sites allocate, and which ones hold memory - at the cost of a          
+   /// thread-local subtraction for each allocation                           
+   /// Allocators call Inner::SampleAllocation and Inner::SampleDeallocation  
+   /// - the thread-caching new/delete does so, when memory statistics are    
+   /// enabled. Call sites are tagged by a ProfilerTag, that is in scope when 
+   /// the sampled allocation is made - LANGULUS_PROFILE_TAG() makes one      
+   /// with LANGULUS_LOCATION(), so samples can be attributed even where      
+   /// stacks can't be captured:                                              
+   ///                                                                        
+   ///   void LoadScene() {                                                   
+   ///      LANGULUS_PROFILE_TAG();                                           
+   ///      ...every allocation in here is tagged with this line              
+   ///   }                                                                    
+   ///                                                                        
+   struct HeapProfiler {
+      static constexpr Offset DefaultPeriod = 512_KiB;
+
+      /// Start sampling - threads that have been allocating while the        
+      /// profiler was idle might allocate up to ProfilerIdleCountdown more   
+      /// bytes, before they notice                                           
+      ///   @param period - mean number of bytes between samples              
+      ///   @return true if started, false if out of memory                   
+      LANGULUS(NOINLINE)
+      static bool Start(const Offset period = DefaultPeriod) noexcept {
+         auto& profiler = Inner::Profiler;
+         profiler.mLock.Lock();
+         if (not profiler.mSamples) {
+            // Sample storage is never freed, so that deallocations can 
+            // safely look for their samples at any time                
+            constexpr auto samples = sizeof(Inner::ProfilerSample) * Inner::ProfilerCapacity;
+            constexpr auto keys = sizeof(Inner::ProfilerKey) * Inner::ProfilerCapacity * 2;
+            constexpr auto bytes = (samples + keys + Inner::PoolPageSize - 1)
+               & ~(Inner::PoolPageSize - 1);
+            const auto memory = Inner::AllocatePages(bytes);
+            if (not memory) {
+               profiler.mLock.Unlock();
+               return false;
+            }
+
+            profiler.mSamples = new (memory) Inner::ProfilerSample[Inner::ProfilerCapacity] {};
+            profiler.mKeys = new (static_cast<char*>(memory) + samples)
+               Inner::ProfilerKey[Inner::ProfilerCapacity * 2] {};
+         }
+
+         profiler.mPeriod.store(period ? period : 1, ::std::memory_order_relaxed);
+         profiler.mActive.store(true, ::std::memory_order_release);
+         profiler.mLock.Unlock();
+         Inner::ProfilerCountdown = 0;
+         return true;
+      }
+
+      /// Stop sampling - existing samples are kept, and deallocations are    
+      /// still tracked                                                       
+      LANGULUS(INLINED)
+      static void Stop() noexcept {
+         Inner::Profiler.mActive.store(false, ::std::memory_order_relaxed);
+      }
+
+      /// Get the number of samples that didn't fit                           
+      NOD() LANGULUS(INLINED)
+      static Count GetDropped() noexcept {
+         return Inner::Profiler.mDropped.load(::std::memory_order_relaxed);
+      }
+
+      /// Serialize all samples as an uncompressed pprof profile, with        
+      /// sample types alloc_objects, alloc_space, inuse_objects and          
+      /// inuse_space. Stacks are raw addresses, which pprof symbolizes       
+      /// against the binaries - on Linux, the mappings are included          
+      /// Tags show up as the innermost function of their samples             
+      ///   @return the profile, readable by 'pprof <binary> <file>'          
+      NOD() LANGULUS(NOINLINE)
+      static ::std::string Dump() {
+         ::std::unordered_map<::std::string, ::std::uint64_t> strings;
+         ::std::unordered_map<Pointer, ::std::uint64_t> addresses;
+         ::std::unordered_map<Token, ::std::uint64_t> tags;
+         Inner::ProfileWriter profile, locations, functions;
+
+         strings.emplace("", 0);
+         const auto intern = [&](const Token& text) {
+            const auto found = strings.try_emplace(::std::string {text}, strings.size());
+            return found.first->second;
+         };
+
+         const auto valueType = [&](const unsigned field, const Token& type, const Token& unit) {
+            Inner::ProfileWriter message;
+            message.Number(1, intern(type));
+            message.Number(2, intern(unit));
+            profile.Bytes(field, message.mBuffer);
+         };
+         valueType(1, "alloc_objects", "count");
+         valueType(1, "alloc_space", "bytes");
+         valueType(1, "inuse_objects", "count");
+         valueType(1, "inuse_space", "bytes");
+         valueType(11, "space", "bytes");
+
+         // Mappings of the executable and shared objects, so that      
+         // pprof can symbolize the addresses                           
+         struct Mapping {
+            Pointer mStart, mEnd;
+            ::std::uint64_t mId;
+         };
+         Mapping mappings[256];
+         Count mappingCount = 0;
+         #if LANGULUS_OS(LINUX)
+            if (const auto maps = ::std::fopen("/proc/self/maps", "r")) {
+               char line[4096];
+               while (mappingCount < 256 and ::std::fgets(line, sizeof(line), maps)) {
+                  unsigned long long start, end, offset;
+                  char permissions[5] {};
+                  int path = -1;
+                  if (::std::sscanf(line, "%llx-%llx %4s %llx %*s %*s %n",
+                     &start, &end, permissions, &offset, &path) < 4
+                  or permissions[2] != 'x' or path < 0)
+                     continue;
+
+                  Token name {line + path};
+                  while (not name.empty() and (name.back() == '\n' or name.back() == ' '))
+                     name.remove_suffix(1);
+
+                  auto& mapping = mappings[mappingCount++];
+                  mapping = {static_cast<Pointer>(start), static_cast<Pointer>(end), mappingCount};
+
+                  Inner::ProfileWriter message;
+                  message.Number(1, mapping.mId);
+                  message.Number(2, start);
+                  message.Number(3, end);
+                  message.Number(4, offset);
+                  message.Number(5, intern(name));
+                  profile.Bytes(3, message.mBuffer);
+               }
+               ::std::fclose(maps);
+            }
+         #endif
+
+         const auto addressLocation = [&](const void* frame) {
+            // Return addresses point after the call instruction        
+            const auto address = reinterpret_cast<Pointer>(frame) - 1;
+            const auto found = addresses.try_emplace(address, addresses.size() + tags.size() + 1);
+            if (found.second) {
+               Inner::ProfileWriter message;
+               message.Number(1, found.first->second);
+               for (Count i = 0; i < mappingCount; ++i) {
+                  if (address >= mappings[i].mStart and address < mappings[i].mEnd) {
+                     message.Number(2, mappings[i].mId);
+                     break;
+                  }
+               }
+               message.Number(3, address);
+               locations.Bytes(4, message.mBuffer);
+            }
+            return found.first->second;
+         };
+
+         const auto tagLocation = [&](const Token& tag) {
+            const auto found = tags.try_emplace(tag, addresses.size() + tags.size() + 1);
+            if (found.second) {
+               // Each tag is both a function, and a location           
+               Inner::ProfileWriter function;
+               function.Number(1, found.first->second);
+               function.Number(2, intern(tag));
+               function.Number(3, intern(tag));
+               functions.Bytes(5, function.mBuffer);
+
+               Inner::ProfileWriter line;
+               line.Number(1, found.first->second);
+               Inner::ProfileWriter message;
+               message.Number(1, found.first->second);
+               message.Bytes(4, line.mBuffer);
+               locations.Bytes(4, message.mBuffer);
+            }
+            return found.first->second;
+         };
+
+         const auto count = ::std::min(
+            Inner::Profiler.mCount.load(::std::memory_order_relaxed),
+            Inner::ProfilerCapacity);
+         for (Count i = 0; i < count; ++i) {
+            // Copy the sample, and skip it if it was being written     
+            // meanwhile, or was never written at all                   
+            const auto& shared = Inner::Profiler.mSamples[i];
+            const auto version = shared.mVersion.load(::std::memory_order_acquire);
+            if (version == 0 or version % 2)
+               continue;
+
+            Inner::ProfilerSample sample;
+            sample.mSize = shared.mSize;
+            sample.mPeriod = shared.mPeriod;
+            sample.mTag = shared.mTag;
+            sample.mDepth = ::std::min(shared.mDepth, Inner::ProfilerDepth);
+            ::std::memcpy(sample.mFrames, shared.mFrames, sizeof(sample.mFrames));
+            const bool live = shared.mAddress.load(::std::memory_order_relaxed) != nullptr;
+            ::std::atomic_thread_fence(::std::memory_order_acquire);
+            if (shared.mVersion.load(::std::memory_order_relaxed) != version)
+               continue;
+
+            ::std::uint64_t ids[Inner::ProfilerDepth + 1];
+            Count depth = 0;
+            if (not sample.mTag.empty())
+               ids[depth++] = tagLocation(sample.mTag);
+            for (Count f = 0; f < sample.mDepth; ++f)
+               ids[depth++] = addressLocation(sample.mFrames[f]);
+
+            // Undo the sampling, by weighting each sample with the     
+            // reciprocal of the probability it had to be sampled       
+            const auto size = static_cast<double>(sample.mSize);
+            const auto probability = 1 - ::std::exp(-size / static_cast<double>(sample.mPeriod));
+            const auto objects = probability > 0 ? 1 / probability : 0;
+            const ::std::uint64_t values[4] {
+               static_cast<::std::uint64_t>(objects + 0.5),
+               static_cast<::std::uint64_t>(objects * size + 0.5),
+               live ? static_cast<::std::uint64_t>(objects + 0.5) : 0,
+               live ? static_cast<::std::uint64_t>(objects * size + 0.5) : 0
+            };
+
+            Inner::ProfileWriter message;
+            message.Packed(1, ids, depth);
+            message.Packed(2, values, 4);
+            profile.Bytes(2, message.mBuffer);
+         }
+
+         profile.mBuffer += locations.mBuffer;
+         profile.mBuffer += functions.mBuffer;
+
+         // The string table has to be in index order                   
+         ::std::vector<Token> ordered(strings.size());
+         for (const auto& string : strings)
+            ordered[string.second] = string.first;
+         for (const auto& string : ordered)
+            profile.Bytes(6, string);
+
+         profile.Number(12, Inner::Profiler.mPeriod.load(::std::memory_order_relaxed));
+         return ::std::move(profile.mBuffer);
+      }
+   };
+
+   ///                                                                        
+   ///   Scope, that tags sampled allocations of the current thread           
+   ///                                                                        
+   /// Scopes nest - the innermost one wins, and the outer one is restored    
+   /// when it ends. Costs nothing per allocation, only sampled ones read     
+   /// the tag                                                                
+   ///                                                                        
+   class ProfilerTag {
+      Token mPrevious;
+
+   public:
+      ProfilerTag(const ProfilerTag&) = delete;
+      ProfilerTag& operator = (const ProfilerTag&) = delete;
+
+      /// Tag allocations until the end of the scope                          
+      ///   @param tag - the tag, like LANGULUS_LOCATION(), must be a         
+      ///                literal, or otherwise outlive the profiler           
+      LANGULUS(INLINED)
+      explicit ProfilerTag(const Token& tag) noexcept
+         : mPrevious {Inner::ProfilerScopeTag} {
+         Inner::ProfilerScopeTag = tag;
+      }
+
+      LANGULUS(INLINED)
+      ~ProfilerTag() {
+         Inner::ProfilerScopeTag = mPrevious;
+      }
+   };
+
+} // namespace Langulus
+
+/// Tag sampled allocations with the current file and line, until the end of  
+/// the scope - one per scope                                                 
+#define LANGULUS_PROFILE_TAG() \
+   const ::Langulus::ProfilerTag LangulusProfilerTag {LANGULUS_LOCATION()}
@@ -0,0 +1,352 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Hash.hpp"
+#include <atomic>
+#include <new>
+
+/// The interning pool has to be shared by everything that is dynamically     
+/// linked, even when building with hidden visibility, or each module would   
+/// get a pool of its own                                                     
+#if (LANGULUS_COMPILER(GCC) or LANGULUS_COMPILER(CLANG)) and not LANGULUS_OS(WINDOWS)
+   #define LANGULUS_INTERN_API() __attribute__ ((visibility("default")))
+#else
+   #define LANGULUS_INTERN_API()
+#endif
+
+
+namespace Langulus
+{
+
+   namespace Inner
+   {
+
+      /// Number of slots in the first table                                  
+      constexpr Count InternFirstCapacity = 1024;
+      /// Number of consecutive slots a string may occupy in a table, before  
+      /// it spills over into the next table                                  
+      constexpr Count InternProbes = 16;
+      /// Maximum number of tables, each four times bigger than the previous  
+      constexpr Count InternMaxTables = Bitness / 4;
+      /// Entries are aligned, so that the lowest bits of their addresses     
+      /// can hold a part of the hash, avoiding most pointer chasing          
+      constexpr ::std::uintptr_t InternTagMask = 15;
+
+      ///                                                                     
+      /// An interned string, followed by its null-terminated letters         
+      /// Never freed, so tokens of it are valid until the process exits      
+      ///                                                                     
+      struct alignas(InternTagMask + 1) InternEntry {
+         Hash mHash;
+         Count mSize;
+
+         NOD() LANGULUS(ALWAYS_INLINED)
+         const Letter* GetLetters() const noexcept {
+            return reinterpret_cast<const Letter*>(this + 1);
+         }
+
+         NOD() LANGULUS(ALWAYS_INLINED)
+         Token GetToken() const noexcept {
+            return {GetLetters(), mSize};
+         }
+      };
+
+      /// A slot holds the address of an entry, and the tag of its hash       
+      using InternSlot = ::std::atomic<::std::uintptr_t>;
+
+      ///                                                                     
+      /// An open-addressing table of interned strings, followed by its slots 
+      /// Slots go from empty to occupied only once, and never change after   
+      /// that, so a string is probed for in the same slots by all threads -  
+      /// if all of them are occupied by other strings, the string can only   
+      /// be in one of the next tables                                        
+      ///                                                                     
+      struct InternTable {
+         // Number of slots, a power-of-two                             
+         Count mCapacity;
+
+         NOD() LANGULUS(ALWAYS_INLINED)
+         InternSlot* GetSlots() noexcept {
+            return reinterpret_cast<InternSlot*>(this + 1);
+         }
+
+         /// Create an empty table                                            
+         ///   @attention throws Except::Allocate if out of memory            
+         NOD() static InternTable* Create(const Count capacity) {
+            const auto memory = ::operator new(sizeof(InternTable)
+               + sizeof(InternSlot) * capacity, ::std::nothrow);
+            if (not memory)
+               Throw<Except::Allocate>("Out of memory", LANGULUS_LOCATION());
+
+            const auto table = new (memory) InternTable {capacity};
+            const auto slots = table->GetSlots();
+            for (Count i = 0; i < capacity; ++i)
+               new (slots + i) InternSlot {0};
+            return table;
+         }
+      };
+
+      ///                                                                     
+      /// The process-wide interning pool                                     
+      ///                                                                     
+      struct InternPool {
+         // The tables, created on demand, each four times bigger than  
+         // the previous one                                            
+         ::std::atomic<InternTable*> mTables[InternMaxTables];
+         // Number of tables - might briefly lag behind a new table     
+         ::std::atomic<Count> mCount;
+      };
+
+      LANGULUS_INTERN_API() inline constinit InternPool Interned {};
+
+      /// Get a table, creating it if it doesn't exist yet                    
+      ///   @param index - the index of the table                             
+      ///   @return the table                                                 
+      ///   @attention throws Except::Allocate if out of memory               
+      NOD() LANGULUS(NOINLINE)
+      inline InternTable* InternTableAt(const Count index) {
+         auto& link = Interned.mTables[index];
+         auto table = link.load(::std::memory_order_acquire);
+         if (table)
+            return table;
+
+         // Another thread might be creating it right now - only one wins
+         const auto created = InternTable::Create(InternFirstCapacity << (index * 2));
+         if (not link.compare_exchange_strong(table, created,
+            ::std::memory_order_acq_rel, ::std::memory_order_acquire)) {
+            ::operator delete(created);
+            return table;
+         }
+
+         auto count = Interned.mCount.load(::std::memory_order_relaxed);
+         while (count <= index and not Interned.mCount.compare_exchange_weak(
+            count, index + 1, ::std::memory_order_release, ::std::memory_order_relaxed));
+         return created;
+      }
+
+      /// Make an entry for a string                                          
+      ///   @attention throws Except::Allocate if out of memory               
+      NOD() LANGULUS(NOINLINE)
+      inline InternEntry* InternCreate(const Token& text, const Hash hash) {
+         const auto memory = ::operator new(sizeof(InternEntry) + text.size() + 1,
+            ::std::align_val_t {alignof(InternEntry)}, ::std::nothrow);
+         if (not memory)
+            Throw<Except::Allocate>("Out of memory", LANGULUS_LOCATION());
+
+         const auto entry = new (memory) InternEntry {hash, text.size()};
+         const auto letters = const_cast<Letter*>(entry->GetLetters());
+         ::std::memcpy(letters, text.data(), text.size());
+         letters[text.size()] = '\0';
+         return entry;
+      }
+
+      /// Get the entry in a slot, if it might hold a string                  
+      ///   @return the entry, or nullptr if the string isn't in the slot     
+      NOD() LANGULUS(ALWAYS_INLINED)
+      const InternEntry* InternMatch(
+         const ::std::uintptr_t slot, const Token& text, const Hash hash
+      ) noexcept {
+         if ((slot & InternTagMask) != (hash.mHash & InternTagMask))
+            return nullptr;
+
+         const auto entry = reinterpret_cast<const InternEntry*>(slot & ~InternTagMask);
+         return entry->mHash == hash and entry->mSize == text.size()
+            and ::std::memcmp(entry->GetLetters(), text.data(), text.size()) == 0
+            ? entry : nullptr;
+      }
+
+      /// Insert a string, unless it's already interned, by walking tables in 
+      /// order, until one of them has the string, or room for it             
+      ///   @param first - the first table that might have room - tables      
+      ///                  before it were seen full, and full is forever      
+      ///   @return the entry, that is the same for all equal strings         
+      ///   @attention throws Except::Allocate if out of memory               
+      NOD() LANGULUS(NOINLINE)
+      inline const InternEntry* InternInsert(const Token& text, const Hash hash, const Count first) {
+         InternEntry* created = nullptr;
+         for (Count index = first; index < InternMaxTables; ++index) {
+            const auto table = InternTableAt(index);
+            const auto slots = table->GetSlots();
+            const auto mask = table->mCapacity - 1;
+            for (Count probe = 0; probe < InternProbes; ++probe) {
+               auto& slot = slots[((hash.mHash >> 4) + probe) & mask];
+               auto word = slot.load(::std::memory_order_acquire);
+               if (not word) {
+                  // Claim the empty slot, unless someone else does     
+                  if (not created)
+                     created = InternCreate(text, hash);
+                  const auto desired = reinterpret_cast<::std::uintptr_t>(created)
+                     | (hash.mHash & InternTagMask);
+                  if (slot.compare_exchange_strong(word, desired,
+                     ::std::memory_order_acq_rel, ::std::memory_order_acquire))
+                     return created;
+               }
+
+               if (const auto entry = InternMatch(word, text, hash)) {
+                  // Someone interned it first, our entry is redundant  
+                  ::operator delete(created, ::std::align_val_t {alignof(InternEntry)});
+                  return entry;
+               }
+            }
+         }
+
+         Throw<Except::Allocate>("Interning pool is full", LANGULUS_LOCATION());
+      }
+
+      /// Find the entry of a string, or insert it, without locking           
+      ///   @param text - the string, must not be empty                       
+      ///   @return the entry, that is the same for all equal strings         
+      ///   @attention throws Except::Allocate if out of memory               
+      NOD() inline const InternEntry* InternFind(const Token& text) {
+         const auto hash = HashBytes(text.data(), text.size());
+
+         // Most strings are interned already, and the newer tables hold
+         // most of them, so look there first - a string is never in more
+         // than one table, so any match is the right one               
+         auto count = Interned.mCount.load(::std::memory_order_acquire);
+         auto first = count;
+         while (count > 0) {
+            const auto table = Interned.mTables[--count].load(::std::memory_order_relaxed);
+            const auto slots = table->GetSlots();
+            const auto mask = table->mCapacity - 1;
+            for (Count probe = 0; probe < InternProbes; ++probe) {
+               const auto word = slots[((hash.mHash >> 4) + probe) & mask]
+                  .load(::std::memory_order_acquire);
+               if (not word) {
+                  first = count;
+                  break;
+               }
+
+               if (const auto entry = InternMatch(word, text, hash))
+                  return entry;
+            }
+         }
+
+         return InternInsert(text, hash, first);
+      }
+
+   } // namespace Langulus::Inner
+
+
+   /// Get the canonical token of a string                                    
+   /// Equal strings always give the same canonical token, so canonical tokens
+   /// can be compared by their data pointers alone. Each string is stored    
+   /// only once per process, and never freed. Safe to call from any thread,  
+   /// without locking                                                        
+   ///   @param text - the string to intern                                   
+   ///   @return the canonical token, or an empty token if text is empty      
+   ///   @attention throws Except::Allocate if out of memory                  
+   NOD() LANGULUS(INLINED)
+   Token Intern(const Token& text) {
+      if (text.empty())
+         return {};
+      return Inner::InternFind(text)->GetToken();
+   }
+
+   ///                                                                        
+   ///   Handle to an interned string                                         
+   ///                                                                        
+   /// A single pointer, that compares in a single instruction, and carries   
+   /// the precomputed hash of the string, so it is a cheap key for maps of   
+   /// names, verbs and traits                                                
+   ///                                                                        
+   class InternedToken {
+      const Inner::InternEntry* mEntry {};
+
+   public:
+      static constexpr bool CTTI_POD = true;
+      static constexpr bool CTTI_Nullifiable = true;
+      static constexpr bool CTTI_BytewiseComparable = true;
+
+      constexpr InternedToken() noexcept = default;
+
+      /// Intern a string                                                     
+      ///   @param text - the string to intern                                
+      ///   @attention throws Except::Allocate if out of memory               
+      LANGULUS(INLINED)
+      explicit InternedToken(const Token& text)
+         : mEntry {text.empty() ? nullptr : Inner::InternFind(text)} {}
+
+      NOD() LANGULUS(INLINED)
+      Token GetToken() const noexcept {
+         return mEntry ? mEntry->GetToken() : Token {};
+      }
+
+      /// Get the hash of the string, that is the same as HashBytes of it     
+      NOD() LANGULUS(INLINED)
+      Hash GetHash() const noexcept {
+         return mEntry ? mEntry->mHash : HashBytes("", 0);
+      }
+
+      NOD() LANGULUS(INLINED)
+      Count GetCount() const noexcept {
+         return mEntry ? mEntry->mSize : 0;
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr bool IsEmpty() const noexcept {
+         return not mEntry;
+      }
+
+      /// The letters are null-terminated                                     
+      NOD() LANGULUS(INLINED)
+      const Letter* GetRaw() const noexcept {
+         return mEntry ? mEntry->GetLetters() : "";
+      }
+
+      LANGULUS(INLINED)
+      operator Token() const noexcept {
+         return GetToken();
+      }
+
+      constexpr bool operator == (const InternedToken&) const noexcept = default;
+   };
+
+   ///                                                                        
+   ///   Memory statistics of the interning pool                              
+   ///                                                                        
+   struct InternStatistics {
+      // Number of interned strings                                     
+      Count mStrings {};
+      // Bytes taken by the strings, including their headers            
+      Offset mStringBytes {};
+      // Number of tables                                               
+      Count mTables {};
+      // Bytes taken by the tables                                      
+      Offset mTableBytes {};
+
+      /// Gather the statistics by scanning all tables                        
+      /// Inserts are never slowed down by bookkeeping, so this is slower     
+      /// than the usual statistics - don't call it in a hot loop             
+      NOD() static InternStatistics Gather() noexcept {
+         InternStatistics result;
+         for (auto& link : Inner::Interned.mTables) {
+            const auto table = link.load(::std::memory_order_acquire);
+            if (not table)
+               break;
+
+            ++result.mTables;
+            result.mTableBytes += sizeof(Inner::InternTable)
+               + sizeof(Inner::InternSlot) * table->mCapacity;
+
+            const auto slots = table->GetSlots();
+            for (Count i = 0; i < table->mCapacity; ++i) {
+               const auto word = slots[i].load(::std::memory_order_acquire);
+               if (word) {
+                  const auto entry = reinterpret_cast<const Inner::InternEntry*>(
+                     word & ~Inner::InternTagMask);
+                  ++result.mStrings;
+                  result.mStringBytes += sizeof(Inner::InternEntry) + entry->mSize + 1;
+               }
+            }
+         }
+         return result;
+      }
+   };
+
+} // namespace Langulus
@@ -0,0 +1,248 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Utilities.hpp"
+
+#if LANGULUS_SIMD(AVX2) or LANGULUS_SIMD(AVX512)
+   #include <immintrin.h>
+#elif LANGULUS_SIMD(SSE2)
+   #include <emmintrin.h>
+#endif
+
+
+namespace Langulus
+{
+   namespace Inner
+   {
+
+      /// Letter classes, that have vectorized kernels                        
+      enum class LetterClass {
+         Custom, Alpha, Space, Digit
+      };
+
+      /// Detect if a predicate is one of the built-in classifiers            
+      ///   @tparam PREDICATE - the predicate to check                        
+      ///   @return the class, or LetterClass::Custom if not built-in         
+      template<auto PREDICATE>
+      consteval LetterClass LetterClassOf() {
+         using P = decltype(PREDICATE);
+         if constexpr (CT::Exact<P, decltype(&IsAlpha)>) {
+            if (PREDICATE == &IsAlpha) return LetterClass::Alpha;
+            if (PREDICATE == &IsSpace) return LetterClass::Space;
+            if (PREDICATE == &IsDigit) return LetterClass::Digit;
+         }
+         return LetterClass::Custom;
+      }
+
+      /// Scalar classification of a single letter                            
+      template<auto PREDICATE> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr bool LetterMatch(const Letter c) noexcept {
+         return static_cast<bool>(PREDICATE(c));
+      }
+
+      /// Scalar classification of up to 64 letters                           
+      ///   @return a mask, where bit i is set if letter i matches            
+      template<auto PREDICATE> NOD() LANGULUS(INLINED)
+      constexpr ::std::uint64_t LetterMaskScalar(const Letter* p, const Count count) noexcept {
+         ::std::uint64_t mask = 0;
+         for (Count i = 0; i < count; ++i)
+            mask |= static_cast<::std::uint64_t>(LetterMatch<PREDICATE>(p[i])) << i;
+         return mask;
+      }
+
+   #if LANGULUS_SIMD(SSE2)
+      /// Classify 16 letters at once                                         
+      ///   @return a 16-bit mask, where bit i is set if letter i matches     
+      template<LetterClass CLASS> NOD() LANGULUS(ALWAYS_INLINED)
+      ::std::uint64_t LetterMask16(const Letter* p) noexcept {
+         const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+         // Unsigned range check, as in (c - from) <= span              
+         const auto inRange = [](__m128i v, char from, char span) noexcept {
+            const __m128i t = _mm_sub_epi8(v, _mm_set1_epi8(from));
+            return _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(span)), t);
+         };
+
+         __m128i m;
+         if constexpr (CLASS == LetterClass::Digit)
+            m = inRange(c, '0', 9);
+         else if constexpr (CLASS == LetterClass::Alpha)
+            m = inRange(_mm_or_si128(c, _mm_set1_epi8(0x20)), 'a', 25);
+         else if constexpr (CLASS == LetterClass::Space) {
+            m = _mm_or_si128(
+               _mm_cmpeq_epi8(c, _mm_set1_epi8(' ')),
+               inRange(c, '\t', '\r' - '\t')
+            );
+         }
+         else static_assert(false, "Unsupported letter class");
+         return static_cast<::std::uint32_t>(_mm_movemask_epi8(m));
+      }
+   #endif
+
+   #if LANGULUS_SIMD(AVX2)
+      /// Classify 32 letters at once                                         
+      ///   @return a 32-bit mask, where bit i is set if letter i matches     
+      template<LetterClass CLASS> NOD() LANGULUS(ALWAYS_INLINED)
+      ::std::uint64_t LetterMask32(const Letter* p) noexcept {
+         const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+         const auto inRange = [](__m256i v, char from, char span) noexcept {
+            const __m256i t = _mm256_sub_epi8(v, _mm256_set1_epi8(from));
+            return _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8(span)), t);
+         };
+
+         __m256i m;
+         if constexpr (CLASS == LetterClass::Digit)
+            m = inRange(c, '0', 9);
+         else if constexpr (CLASS == LetterClass::Alpha)
+            m = inRange(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), 'a', 25);
+         else if constexpr (CLASS == LetterClass::Space) {
+            m = _mm256_or_si256(
+               _mm256_cmpeq_epi8(c, _mm256_set1_epi8(' ')),
+               inRange(c, '\t', '\r' - '\t')
+            );
+         }
+         else static_assert(false, "Unsupported letter class");
+         return static_cast<::std::uint32_t>(_mm256_movemask_epi8(m));
+      }
+   #endif
+
+   #if LANGULUS_SIMD(SSE2)
+      /// Classify 64 letters at once, using the widest available registers   
+      ///   @return a 64-bit mask, where bit i is set if letter i matches     
+      template<LetterClass CLASS> NOD() LANGULUS(ALWAYS_INLINED)
+      ::std::uint64_t LetterMask64(const Letter* p) noexcept {
+         #if LANGULUS_SIMD(AVX512)
+            const __m512i c = _mm512_loadu_si512(p);
+            const auto inRange = [](__m512i v, char from, char span) noexcept {
+               const __m512i t = _mm512_sub_epi8(v, _mm512_set1_epi8(from));
+               return _mm512_cmple_epu8_mask(t, _mm512_set1_epi8(span));
+            };
+
+            if constexpr (CLASS == LetterClass::Digit)
+               return inRange(c, '0', 9);
+            else if constexpr (CLASS == LetterClass::Alpha)
+               return inRange(_mm512_or_si512(c, _mm512_set1_epi8(0x20)), 'a', 25);
+            else if constexpr (CLASS == LetterClass::Space) {
+               return _mm512_cmpeq_epi8_mask(c, _mm512_set1_epi8(' '))
+                    | inRange(c, '\t', '\r' - '\t');
+            }
+            else static_assert(false, "Unsupported letter class");
+         #elif LANGULUS_SIMD(AVX2)
+            return LetterMask32<CLASS>(p)
+                | (LetterMask32<CLASS>(p + 32) << 32);
+         #else
+            return LetterMask16<CLASS>(p)
+                | (LetterMask16<CLASS>(p + 16) << 16)
+                | (LetterMask16<CLASS>(p + 32) << 32)
+                | (LetterMask16<CLASS>(p + 48) << 48);
+         #endif
+      }
+   #endif
+
+      /// Find the first letter that matches (or doesn't match) a predicate   
+      ///   @tparam PREDICATE - the classifier                                
+      ///   @tparam MATCH - whether to search for a match, or a mismatch      
+      ///   @param text - the text to scan                                    
+      ///   @return the offset of the letter, or text.size() if not found     
+      template<auto PREDICATE, bool MATCH> NOD() LANGULUS(INLINED)
+      constexpr Offset LetterFind(const Token& text) noexcept {
+         const auto p = text.data();
+         const auto n = text.size();
+         Offset i = 0;
+
+         #if LANGULUS_SIMD(SSE2)
+            constexpr auto CLASS = LetterClassOf<PREDICATE>();
+            IF_CONSTEXPR() {}
+            else if constexpr (CLASS != LetterClass::Custom) {
+               for (; i + 64 <= n; i += 64) {
+                  auto m = LetterMask64<CLASS>(p + i);
+                  if constexpr (not MATCH)
+                     m = ~m;
+                  if (m)
+                     return i + CountTrailingZeroes(m);
+               }
+
+               for (; i + 16 <= n; i += 16) {
+                  auto m = LetterMask16<CLASS>(p + i);
+                  if constexpr (not MATCH)
+                     m = ~m & 0xFFFF;
+                  if (m)
+                     return i + CountTrailingZeroes(m);
+               }
+            }
+         #endif
+
+         for (; i < n; ++i) {
+            if (LetterMatch<PREDICATE>(p[i]) == MATCH)
+               return i;
+         }
+         return n;
+      }
+
+   } // namespace Langulus::Inner
+
+
+   /// Find the first letter in a text, that matches a predicate              
+   /// The built-in IsAlpha, IsSpace and IsDigit are vectorized, and scan up  
+   /// to 64 letters per step, any other predicate is applied letter by letter
+   ///   @tparam PREDICATE - the classifier, like IsDigit                     
+   ///   @param text - the text to scan                                       
+   ///   @return the offset of the first matching letter, or text.size()      
+   template<auto PREDICATE> NOD() LANGULUS(INLINED)
+   constexpr Offset FindFirst(const Token& text) noexcept {
+      return Inner::LetterFind<PREDICATE, true>(text);
+   }
+
+   /// Find the first letter in a text, that doesn't match a predicate        
+   /// The built-in IsAlpha, IsSpace and IsDigit are vectorized, and scan up  
+   /// to 64 letters per step, any other predicate is applied letter by letter
+   ///   @tparam PREDICATE - the classifier, like IsDigit                     
+   ///   @param text - the text to scan                                       
+   ///   @return the offset of the first mismatching letter, or text.size()   
+   template<auto PREDICATE> NOD() LANGULUS(INLINED)
+   constexpr Offset FindFirstNot(const Token& text) noexcept {
+      return Inner::LetterFind<PREDICATE, false>(text);
+   }
+
+   /// Count the leading whitespaces in a text                                
+   ///   @param text - the text to scan                                       
+   ///   @return the number of leading spaces, same as the offset of the      
+   ///           first non-space letter                                       
+   NOD() LANGULUS(INLINED)
+   constexpr Offset SkipSpaces(const Token& text) noexcept {
+      return FindFirstNot<IsSpace>(text);
+   }
+
+   /// Classify up to the first 64 letters of a text                          
+   ///   @tparam PREDICATE - the classifier, like IsAlpha                     
+   ///   @param text - the text to classify                                   
+   ///   @return a mask, where bit i is set if letter i matches the predicate,
+   ///           bits beyond text.size() are always zero                      
+   template<auto PREDICATE> NOD() LANGULUS(INLINED)
+   constexpr ::std::uint64_t ClassifyMask(const Token& text) noexcept {
+      const auto p = text.data();
+      const auto n = text.size() < 64 ? text.size() : 64;
+
+      #if LANGULUS_SIMD(SSE2)
+         constexpr auto CLASS = Inner::LetterClassOf<PREDICATE>();
+         IF_CONSTEXPR() {}
+         else if constexpr (CLASS != Inner::LetterClass::Custom) {
+            if (n == 64)
+               return Inner::LetterMask64<CLASS>(p);
+
+            ::std::uint64_t mask = 0;
+            Offset i = 0;
+            for (; i + 16 <= n; i += 16)
+               mask |= Inner::LetterMask16<CLASS>(p + i) << i;
+            return mask | (Inner::LetterMaskScalar<PREDICATE>(p + i, n - i) << i);
+         }
+      #endif
+
+      return Inner::LetterMaskScalar<PREDICATE>(p, n);
+   }
+
+} // namespace Langulus
@@ -0,0 +1,325 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Pool.hpp"
+
+
+namespace Langulus
+{
+
+   namespace Inner
+   {
+
+      /// Number of Roof2 size classes in the live allocation histogram -     
+      /// one for each power-of-two, from 1 byte up to 2^Bitness bytes        
+      constexpr Count StatisticsClassCount = Bitness + 1;
+
+      /// Live bytes are published globally only after a thread's local       
+      /// delta exceeds this, so peak is accurate to within that many bytes   
+      /// per thread                                                          
+      constexpr Offset StatisticsBatch = 64_KiB;
+
+      /// Get the Roof2 size class of an allocation                           
+      ///   @param size - the number of bytes                                 
+      ///   @return the class index, where class n holds sizes in             
+      ///           (2^(n-1), 2^n]                                            
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr Count StatisticsClassOf(const Offset size) noexcept {
+         return size <= 1 ? 0
+            : static_cast<Count>(Bitness - CountLeadingZeroes(size - 1));
+      }
+
+      ///                                                                     
+      /// Counters of a single thread                                         
+      ///                                                                     
+      /// Only the owner thread ever writes them, so they are updated with    
+      /// plain relaxed loads and stores, instead of atomic read-modify-write 
+      /// operations, and are read by Snapshot from any thread. Each set is   
+      /// aligned to a cache line, so that threads never share one            
+      /// Memory might be freed by a different thread than the one that       
+      /// allocated it, so a single thread's live histogram might wrap        
+      /// around - only the sum over all threads is meaningful                
+      ///                                                                     
+      struct alignas(CacheLine) StatisticsCounters {
+         ::std::atomic<Offset> mAllocatedBytes;
+         ::std::atomic<Offset> mAllocations;
+         ::std::atomic<Offset> mFreedBytes;
+         ::std::atomic<Offset> mFrees;
+         ::std::atomic<Offset> mReallocatedBytes;
+         ::std::atomic<Offset> mReallocations;
+         ::std::atomic<Offset> mLive[StatisticsClassCount];
+         // Live bytes, allocated minus freed, including reallocations  
+         ::std::atomic<Offset> mLiveBytes;
+         // Live bytes, not yet published to the registry               
+         ::std::ptrdiff_t mPending;
+         // The next counter set in the registry                        
+         StatisticsCounters* mNext;
+         // True if the owner thread has exited                         
+         ::std::atomic<bool> mAbandoned;
+
+         /// Add to a counter, that only this thread writes                   
+         LANGULUS(ALWAYS_INLINED)
+         static void Add(::std::atomic<Offset>& counter, const Offset value) noexcept {
+            counter.store(counter.load(::std::memory_order_relaxed) + value,
+               ::std::memory_order_relaxed);
+         }
+      };
+
+      ///                                                                     
+      /// Counter sets of all threads that ever recorded anything             
+      ///                                                                     
+      struct StatisticsRegistry {
+         // All counter sets, only ever prepended to                    
+         ::std::atomic<StatisticsCounters*> mCounters;
+         // Live bytes, published by all threads in batches             
+         ::std::atomic<::std::ptrdiff_t> mLiveBytes;
+         // The most live bytes ever published                          
+         ::std::atomic<::std::ptrdiff_t> mPeakBytes;
+         // Protects the counter set storage                            
+         SpinLock mLock;
+         // Where to carve the next counter set from                    
+         Pointer mCursor;
+         Pointer mEnd;
+      };
+
+      /// Counter sets are never freed, because threads that exit still       
+      /// count towards the totals, and their sets get adopted by new ones    
+      inline constinit StatisticsRegistry Statistics {};
+
+      /// The counters of the current thread, or nullptr if not yet acquired  
+      inline constinit thread_local StatisticsCounters* CurrentStatistics = nullptr;
+      /// Set after the current thread has released its counters on exit      
+      inline constinit thread_local bool CurrentStatisticsReleased = false;
+
+      /// Publish the live bytes the current thread has accumulated, and      
+      /// update the peak                                                     
+      ///   @param counters - the current thread's counters                   
+      LANGULUS(NOINLINE)
+      inline void PublishStatistics(StatisticsCounters* counters) noexcept {
+         const auto live = Statistics.mLiveBytes.fetch_add(
+            counters->mPending, ::std::memory_order_relaxed) + counters->mPending;
+         counters->mPending = 0;
+
+         auto peak = Statistics.mPeakBytes.load(::std::memory_order_relaxed);
+         while (live > peak and not Statistics.mPeakBytes.compare_exchange_weak(
+            peak, live, ::std::memory_order_relaxed));
+      }
+
+      /// Give the current thread's counters up for adoption                  
+      LANGULUS(NOINLINE)
+      inline void ReleaseStatistics() noexcept {
+         const auto counters = CurrentStatistics;
+         if (not counters)
+            return;
+
+         PublishStatistics(counters);
+         CurrentStatistics = nullptr;
+         CurrentStatisticsReleased = true;
+         counters->mAbandoned.store(true, ::std::memory_order_release);
+      }
+
+      /// Releases the current thread's counters, when the thread exits       
+      struct StatisticsGuard {
+         LANGULUS(INLINED)
+         ~StatisticsGuard() {
+            ReleaseStatistics();
+         }
+      };
+
+      inline thread_local StatisticsGuard CurrentStatisticsGuard;
+
+      /// Adopt the counters of an exited thread, or create new ones          
+      ///   @return the counters, or nullptr if out of memory                 
+      NOD() LANGULUS(NOINLINE)
+      inline StatisticsCounters* AcquireStatistics() noexcept {
+         auto counters = Statistics.mCounters.load(::std::memory_order_acquire);
+         while (counters) {
+            bool abandoned = true;
+            if (counters->mAbandoned.load(::std::memory_order_relaxed)
+            and counters->mAbandoned.compare_exchange_strong(abandoned, false,
+               ::std::memory_order_acquire, ::std::memory_order_relaxed))
+               break;
+            counters = counters->mNext;
+         }
+
+         if (not counters) {
+            // Counter sets are carved from pages, that are never freed 
+            Statistics.mLock.Lock();
+            if (Statistics.mCursor + sizeof(StatisticsCounters) > Statistics.mEnd) {
+               const auto memory = AllocatePages(PoolPageSize);
+               if (not memory) {
+                  Statistics.mLock.Unlock();
+                  return nullptr;
+               }
+
+               Statistics.mCursor = reinterpret_cast<Pointer>(memory);
+               Statistics.mEnd = Statistics.mCursor + PoolPageSize;
+            }
+
+            counters = new (reinterpret_cast<void*>(Statistics.mCursor))
+               StatisticsCounters {};
+            Statistics.mCursor += sizeof(StatisticsCounters);
+            Statistics.mLock.Unlock();
+
+            counters->mNext = Statistics.mCounters.load(::std::memory_order_relaxed);
+            while (not Statistics.mCounters.compare_exchange_weak(
+               counters->mNext, counters,
+               ::std::memory_order_release, ::std::memory_order_relaxed));
+         }
+
+         // Touching the guard registers its destructor for this thread 
+         if (not CurrentStatisticsReleased)
+            (void) &CurrentStatisticsGuard;
+         CurrentStatistics = counters;
+         return counters;
+      }
+
+      /// Get the current thread's counters                                   
+      ///   @return the counters, or nullptr if out of memory                 
+      NOD() LANGULUS(ALWAYS_INLINED)
+      StatisticsCounters* GetStatistics() noexcept {
+         const auto counters = CurrentStatistics;
+         if (counters) LIKELY()
+            return counters;
+         return AcquireStatistics();
+      }
+
+      /// Account for a change in the current thread's live bytes             
+      LANGULUS(ALWAYS_INLINED)
+      void AccumulateStatistics(StatisticsCounters* counters, const ::std::ptrdiff_t delta) noexcept {
+         StatisticsCounters::Add(counters->mLiveBytes, static_cast<Offset>(delta));
+         counters->mPending += delta;
+         if (counters->mPending >= static_cast<::std::ptrdiff_t>(StatisticsBatch)
+         or  counters->mPending <= -static_cast<::std::ptrdiff_t>(StatisticsBatch))
+            PublishStatistics(counters);
+      }
+
+      /// Record an allocation on the current thread                          
+      ///   @param bytes - the size of the allocation                         
+      LANGULUS(INLINED)
+      void RecordAllocation(const Offset bytes) noexcept {
+         const auto counters = GetStatistics();
+         if (not counters) UNLIKELY()
+            return;
+
+         StatisticsCounters::Add(counters->mAllocatedBytes, bytes);
+         StatisticsCounters::Add(counters->mAllocations, 1);
+         StatisticsCounters::Add(counters->mLive[StatisticsClassOf(bytes)], 1);
+         AccumulateStatistics(counters, static_cast<::std::ptrdiff_t>(bytes));
+      }
+
+      /// Record a deallocation on the current thread                         
+      ///   @param bytes - the size of the allocation                         
+      LANGULUS(INLINED)
+      void RecordDeallocation(const Offset bytes) noexcept {
+         const auto counters = GetStatistics();
+         if (not counters) UNLIKELY()
+            return;
+
+         StatisticsCounters::Add(counters->mFreedBytes, bytes);
+         StatisticsCounters::Add(counters->mFrees, 1);
+         StatisticsCounters::Add(counters->mLive[StatisticsClassOf(bytes)], Offset(-1));
+         AccumulateStatistics(counters, -static_cast<::std::ptrdiff_t>(bytes));
+      }
+
+      /// Record a reallocation on the current thread                         
+      ///   @param oldBytes - the size of the allocation before               
+      ///   @param newBytes - the size of the allocation after                
+      LANGULUS(INLINED)
+      void RecordReallocation(const Offset oldBytes, const Offset newBytes) noexcept {
+         const auto counters = GetStatistics();
+         if (not counters) UNLIKELY()
+            return;
+
+         StatisticsCounters::Add(counters->mReallocatedBytes, newBytes);
+         StatisticsCounters::Add(counters->mReallocations, 1);
+         const auto oldClass = StatisticsClassOf(oldBytes);
+         const auto newClass = StatisticsClassOf(newBytes);
+         if (oldClass != newClass) {
+            StatisticsCounters::Add(counters->mLive[oldClass], Offset(-1));
+            StatisticsCounters::Add(counters->mLive[newClass], 1);
+         }
+         AccumulateStatistics(counters, static_cast<::std::ptrdiff_t>(newBytes)
+                                      - static_cast<::std::ptrdiff_t>(oldBytes));
+      }
+
+   } // namespace Langulus::Inner
+
+
+   ///                                                                        
+   ///   Memory statistics                                                    
+   ///                                                                        
+   /// A snapshot of the counters of all threads, that ever allocated through 
+   /// the thread-caching new/delete - operator new and delete, once          
+   /// LANGULUS_MONOPOLIZE_MEMORY() is used, and Inner::NewDeleteAllocate,    
+   /// NewDeleteFree and NewDeleteReallocate directly. Only those record      
+   /// anything - PoolAllocator and MonotonicArena are building blocks, and   
+   /// don't, so that allocators built on top of them aren't counted twice    
+   /// Counters are gathered without any locking, while other threads keep    
+   /// allocating, so the snapshot isn't atomic as a whole, but each counter  
+   /// is exact at the time it was read                                       
+   ///                                                                        
+   struct MemoryStatistics {
+      // Total bytes and number of allocations, ever made               
+      Offset mAllocatedBytes {};
+      Offset mAllocations {};
+      // Total bytes and number of deallocations, ever made             
+      Offset mFreedBytes {};
+      Offset mFrees {};
+      // Total bytes after reallocation, and number of reallocations    
+      Offset mReallocatedBytes {};
+      Offset mReallocations {};
+      // Bytes currently in use                                         
+      Offset mLiveBytes {};
+      // The most bytes that were ever in use                           
+      Offset mPeakBytes {};
+      // Number of live allocations in each Roof2 size class            
+      Count mLive[Inner::StatisticsClassCount] {};
+      // Number of threads that have recorded anything, including exited
+      Count mThreads {};
+
+      /// Gather the counters of all threads, without waiting for any         
+      ///   @return the statistics                                            
+      NOD() LANGULUS(NOINLINE)
+      static MemoryStatistics Snapshot() noexcept {
+         MemoryStatistics result;
+         auto counters = Inner::Statistics.mCounters.load(::std::memory_order_acquire);
+         while (counters) {
+            constexpr auto relaxed = ::std::memory_order_relaxed;
+            result.mAllocatedBytes += counters->mAllocatedBytes.load(relaxed);
+            result.mAllocations += counters->mAllocations.load(relaxed);
+            result.mFreedBytes += counters->mFreedBytes.load(relaxed);
+            result.mFrees += counters->mFrees.load(relaxed);
+            result.mReallocatedBytes += counters->mReallocatedBytes.load(relaxed);
+            result.mReallocations += counters->mReallocations.load(relaxed);
+            for (Count i = 0; i < Inner::StatisticsClassCount; ++i)
+               result.mLive[i] += counters->mLive[i].load(relaxed);
+            result.mLiveBytes += counters->mLiveBytes.load(relaxed);
+            ++result.mThreads;
+            counters = counters->mNext;
+         }
+
+         // Counters are read at slightly different times, so the sum   
+         // might momentarily dip below zero                            
+         const auto live = static_cast<::std::ptrdiff_t>(result.mLiveBytes);
+         result.mLiveBytes = live > 0 ? static_cast<Offset>(live) : 0;
+         const auto peak = Inner::Statistics.mPeakBytes.load(::std::memory_order_relaxed);
+         result.mPeakBytes = peak > live ? static_cast<Offset>(peak) : result.mLiveBytes;
+         return result;
+      }
+
+      /// Get the size class of an entry in the live histogram                
+      ///   @param index - the index of the class                             
+      ///   @return the biggest allocation size in that class                 
+      NOD() LANGULUS(INLINED)
+      static constexpr Offset GetClassSize(const Count index) noexcept {
+         return index < Bitness ? Offset {1} << index : OffsetMax;
+      }
+   };
+
+} // namespace Langulus
@@ -0,0 +1,178 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "CPU.hpp"
+#include <atomic>
+
+/// Build a function for an instruction set, regardless of the build flags,   
+/// so that it can be a variant of a Multiversion kernel. The intrinsics of   
+/// that instruction set become usable inside it:                             
+///   LANGULUS_TARGET(AVX2) int SumAVX2(const int*, Count) noexcept;          
+/// MSVC allows any intrinsic anywhere, so there it does nothing              
+#define LANGULUS_TARGET(a) LANGULUS_TARGET_##a()
+
+#if (LANGULUS_COMPILER(GCC) or LANGULUS_COMPILER(CLANG)) and LANGULUS_ARCH(X86)
+   #define LANGULUS_TARGET_SCALAR()
+   #define LANGULUS_TARGET_SSE2()   __attribute__((target("sse2")))
+   #define LANGULUS_TARGET_AVX2()   __attribute__((target("avx2,fma,f16c,bmi,bmi2,popcnt")))
+   #define LANGULUS_TARGET_AVX512() __attribute__((target("avx512f,avx512bw,avx2,fma,f16c,bmi,bmi2,popcnt")))
+#else
+   #define LANGULUS_TARGET_SCALAR()
+   #define LANGULUS_TARGET_SSE2()
+   #define LANGULUS_TARGET_AVX2()
+   #define LANGULUS_TARGET_AVX512()
+#endif
+
+
+namespace Langulus
+{
+
+   /// Instruction set levels, that kernels can have variants for             
+   /// Each level includes everything the previous ones have, and is the      
+   /// same set of extensions LANGULUS_TARGET enables                         
+   enum class ISA {
+      Scalar, SSE2, AVX2, AVX512
+   };
+
+   /// The level, that the code was built for via LANGULUS_SIMD flags         
+   constexpr ISA BuiltISA = LANGULUS_SIMD(AVX512) ? ISA::AVX512
+                          : LANGULUS_SIMD(AVX2)   ? ISA::AVX2
+                          : LANGULUS_SIMD(SSE2)   ? ISA::SSE2
+                          : ISA::Scalar;
+
+   /// Get the highest level, that a processor supports                       
+   ///   @param cpu - the processor, see CPU::Get()                           
+   ///   @return the level                                                    
+   NOD() LANGULUS(INLINED)
+   constexpr ISA ISAOf(const CPU& cpu) noexcept {
+      const bool avx2 = cpu.mAVX2 and cpu.mFMA and cpu.mF16C and cpu.mBMI1
+                    and cpu.mBMI2 and cpu.mPOPCNT;
+      if (avx2 and cpu.mAVX512)
+         return ISA::AVX512;
+      if (avx2)
+         return ISA::AVX2;
+      if (cpu.mSSE2)
+         return ISA::SSE2;
+      return ISA::Scalar;
+   }
+
+   namespace Inner
+   {
+
+      /// Generates a function with the signature of a kernel, that resolves  
+      /// the kernel on its first call, and forwards to it                    
+      template<class F>
+      struct MultiversionTrampoline;
+
+      template<class R, class... A>
+      struct MultiversionTrampoline<R(*)(A...)> {
+         template<class M>
+         static R Call(A... args) {
+            return M::Resolve()(static_cast<A&&>(args)...);
+         }
+      };
+
+      template<class R, class... A>
+      struct MultiversionTrampoline<R(*)(A...) noexcept> {
+         template<class M>
+         static R Call(A... args) noexcept {
+            return M::Resolve()(static_cast<A&&>(args)...);
+         }
+      };
+
+   } // namespace Langulus::Inner
+
+
+   ///                                                                        
+   ///   A kernel with variants for different instruction sets                
+   ///                                                                        
+   /// The best variant for the host is picked on the first call, and the     
+   /// call goes through a function pointer from then on, so the binary can   
+   /// be built for the lowest common instruction set, without leaving the    
+   /// wider ones unused. If the code is built with flags, that already       
+   /// guarantee the best variant, it is called directly, and can be inlined  
+   /// The first call may happen at any point, even during static init:       
+   ///                                                                        
+   ///   Count SumScalar(const int*, Count) noexcept;                         
+   ///   LANGULUS_TARGET(AVX2) Count SumAVX2(const int*, Count) noexcept;     
+   ///   constexpr Multiversion<&SumScalar, nullptr, &SumAVX2> Sum;           
+   ///   auto total = Sum(data, count);                                       
+   ///                                                                        
+   ///   @tparam SCALAR - the fallback, that runs anywhere                    
+   ///   @tparam SSE2, AVX2, AVX512 - the variants, nullptr if missing, all   
+   ///      of them must have the same type as SCALAR                         
+   ///                                                                        
+   template<auto SCALAR, auto SSE2 = nullptr, auto AVX2 = nullptr, auto AVX512 = nullptr>
+   class Multiversion {
+   public:
+      using Function = decltype(SCALAR);
+      static_assert(CT::Function<Deptr<Function>>,
+         "SCALAR must be a pointer to a function");
+      static_assert((CT::Nullptr<decltype(SSE2)> or CT::Exact<decltype(SSE2), Function>)
+                and (CT::Nullptr<decltype(AVX2)> or CT::Exact<decltype(AVX2), Function>)
+                and (CT::Nullptr<decltype(AVX512)> or CT::Exact<decltype(AVX512), Function>),
+         "All variants must have the same type as SCALAR, or be nullptr");
+
+   private:
+      static constexpr Function Variants[] {
+         SCALAR, Function {SSE2}, Function {AVX2}, Function {AVX512}
+      };
+
+      /// The level of the best variant, if the build flags already           
+      /// guarantee it, or -1 if it has to be picked at runtime               
+      static consteval int GetStaticLevel() noexcept {
+         for (int level = static_cast<int>(ISA::AVX512); level > 0; --level) {
+            if (Variants[level])
+               return level <= static_cast<int>(BuiltISA) ? level : -1;
+         }
+         return 0;
+      }
+
+      static constexpr int StaticLevel = GetStaticLevel();
+
+      // Starts at the trampoline, and is patched on the first call     
+      static inline constinit ::std::atomic<Function> Resolved {
+         &Inner::MultiversionTrampoline<Function>::template Call<Multiversion>
+      };
+
+   public:
+      /// Get the best variant, up to a level                                 
+      /// Use it to test and benchmark the variants against each other        
+      ///   @param level - the highest level to consider                      
+      ///   @return the variant                                               
+      NOD() LANGULUS(INLINED)
+      static constexpr Function Select(const ISA level) noexcept {
+         for (int i = static_cast<int>(level); i > 0; --i) {
+            if (Variants[i])
+               return Variants[i];
+         }
+         return SCALAR;
+      }
+
+      /// Pick the best variant for the host, and call it from now on         
+      /// Threads may race to do it, but they all pick the same variant       
+      ///   @return the variant                                               
+      LANGULUS(NOINLINE)
+      static Function Resolve() noexcept {
+         const auto best = Select(ISAOf(CPU::Get()));
+         Resolved.store(best, ::std::memory_order_relaxed);
+         return best;
+      }
+
+      /// Call the best variant                                               
+      template<class... A> LANGULUS(INLINED)
+      decltype(auto) operator () (A&&... args) const
+      noexcept(noexcept(SCALAR(::std::forward<A>(args)...))) {
+         if constexpr (StaticLevel >= 0)
+            return Variants[StaticLevel](::std::forward<A>(args)...);
+         else
+            return Resolved.load(::std::memory_order_relaxed)(::std::forward<A>(args)...);
+      }
+   };
+
+} // namespace Langulus
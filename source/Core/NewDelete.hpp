@@ -0,0 +1,353 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "MemoryStatistics.hpp"
+#include "HeapProfiler.hpp"
+
+/// Replacement new/delete operators have to be visible from anything that    
+/// is dynamically linked, even when building with hidden visibility          
+#if (LANGULUS_COMPILER(GCC) or LANGULUS_COMPILER(CLANG)) and not LANGULUS_OS(WINDOWS)
+   #define LANGULUS_NEWDELETE_API() __attribute__ ((visibility("default")))
+#else
+   #define LANGULUS_NEWDELETE_API()
+#endif
+
+
+namespace Langulus
+{
+
+   namespace Inner
+   {
+
+      ///                                                                     
+      /// A pool, that is owned by a thread, or is waiting to be adopted by a 
+      /// new thread, after its previous owner has exited. Heaps are never    
+      /// destroyed, because memory from them might be freed at any time      
+      ///                                                                     
+      struct ThreadHeap {
+         PoolAllocator mPool;
+         // The next heap in the list of all heaps                      
+         ThreadHeap* mNextHeap {};
+         // True if the owner thread has exited                         
+         ::std::atomic<bool> mAbandoned {};
+
+         LANGULUS(INLINED)
+         constexpr explicit ThreadHeap(PageCache* cache) noexcept
+            : mPool {cache} {}
+      };
+
+      ///                                                                     
+      /// State, that is shared between all threads                           
+      ///                                                                     
+      struct HeapRegistry {
+         // Empty pages, traded between thread heaps in batches         
+         PageCache mCache {PageCache::DefaultLimit};
+         // Protects the heap list, and the heap storage                
+         SpinLock mLock;
+         // All heaps that were ever created                            
+         ThreadHeap* mHeaps {};
+         // Where to carve the next heap from                           
+         Pointer mCursor {};
+         Pointer mEnd {};
+      };
+
+      /// Never destroyed, because memory might be freed even after all static
+      /// destructors were called                                             
+      union HeapRegistryHolder {
+         HeapRegistry mValue;
+
+         constexpr HeapRegistryHolder() noexcept : mValue {} {}
+         ~HeapRegistryHolder() {}
+      };
+
+      inline constinit HeapRegistryHolder Heaps;
+
+      /// The heap of the current thread, or nullptr if not yet acquired      
+      inline constinit thread_local ThreadHeap* CurrentHeap = nullptr;
+      /// Set after the current thread has released its heap on exit          
+      inline constinit thread_local bool CurrentHeapReleased = false;
+
+      /// Give the current thread's heap up for adoption, keeping its pages   
+      /// and allocations intact, but collecting any remote deallocations,    
+      /// and returning its spare pages to the shared cache                   
+      LANGULUS(NOINLINE)
+      inline void ReleaseHeap() noexcept {
+         const auto heap = CurrentHeap;
+         if (not heap)
+            return;
+
+         heap->mPool.Collect();
+         heap->mPool.Trim();
+         CurrentHeap = nullptr;
+         CurrentHeapReleased = true;
+         heap->mAbandoned.store(true, ::std::memory_order_release);
+      }
+
+      /// Releases the current thread's heap, when the thread exits           
+      struct HeapGuard {
+         LANGULUS(INLINED)
+         ~HeapGuard() {
+            ReleaseHeap();
+         }
+      };
+
+      inline thread_local HeapGuard CurrentHeapGuard;
+
+      /// Adopt an abandoned heap, or create a new one for the current thread 
+      /// If something allocates after the thread has released its heap (from 
+      /// another thread_local destructor, for example), a heap is acquired   
+      /// again, but is never released                                        
+      ///   @return the heap, or nullptr if out of memory                     
+      NOD() LANGULUS(NOINLINE)
+      inline ThreadHeap* AcquireHeap() noexcept {
+         auto& registry = Heaps.mValue;
+         registry.mLock.Lock();
+         auto heap = registry.mHeaps;
+         while (heap and not heap->mAbandoned.load(::std::memory_order_acquire))
+            heap = heap->mNextHeap;
+
+         if (heap)
+            heap->mAbandoned.store(false, ::std::memory_order_relaxed);
+         else {
+            // Heaps are carved from pages, that are never freed        
+            if (registry.mCursor + sizeof(ThreadHeap) > registry.mEnd) {
+               const auto memory = AllocatePages(PoolPageSize);
+               if (not memory) {
+                  registry.mLock.Unlock();
+                  return nullptr;
+               }
+
+               registry.mCursor = reinterpret_cast<Pointer>(memory);
+               registry.mEnd = registry.mCursor + PoolPageSize;
+            }
+
+            heap = new (reinterpret_cast<void*>(registry.mCursor))
+               ThreadHeap {&registry.mCache};
+            registry.mCursor += sizeof(ThreadHeap);
+            heap->mNextHeap = registry.mHeaps;
+            registry.mHeaps = heap;
+         }
+         registry.mLock.Unlock();
+
+         // Touching the guard registers its destructor for this thread 
+         if (not CurrentHeapReleased)
+            (void) &CurrentHeapGuard;
+         CurrentHeap = heap;
+         return heap;
+      }
+
+      /// The alignment, that operator new without align_val_t has to honor   
+      /// Langulus' own Alignment might be as big as a cache line, and small  
+      /// allocations are rounded up to their alignment, so it is left only   
+      /// for the Langulus entry points, that default to it                   
+      constexpr Offset NewDeleteAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+      /// Allocate from the current thread's heap                             
+      ///   @param size - number of bytes                                     
+      ///   @param alignment - the alignment, must be a power-of-two          
+      ///   @return the memory, or nullptr if out of memory                   
+      NOD() LANGULUS(INLINED)
+      void* NewDeleteAllocate(const Offset size, const Offset alignment = Alignment) noexcept {
+         auto heap = CurrentHeap;
+         if (not heap) UNLIKELY() {
+            heap = AcquireHeap();
+            if (not heap)
+               return nullptr;
+         }
+
+         const auto memory = heap->mPool.Allocate(::std::nothrow, size, alignment);
+         #if LANGULUS_FEATURE(MEMORY_STATISTICS)
+            if (memory) LIKELY() {
+               const auto bytes = PoolAllocator::SizeOf(memory);
+               RecordAllocation(bytes);
+               SampleAllocation(memory, bytes);
+            }
+         #endif
+         return memory;
+      }
+
+      /// Allocate from the current thread's heap, as operator new would      
+      ///   @param size - number of bytes                                     
+      ///   @param alignment - the alignment, must be a power-of-two          
+      ///   @return the memory, never nullptr                                 
+      ///   @attention calls the new-handler, or throws std::bad_alloc if out 
+      ///              of memory                                              
+      NOD() LANGULUS(INLINED)
+      void* NewDeleteAllocateOrThrow(const Offset size, const Offset alignment = Alignment) {
+         while (true) {
+            const auto memory = NewDeleteAllocate(size, alignment);
+            if (memory) LIKELY()
+               return memory;
+
+            const auto handler = ::std::get_new_handler();
+            if (not handler) {
+               #if LANGULUS(EXCEPTIONS)
+                  throw ::std::bad_alloc {};
+               #else
+                  Throw<Except::Allocate>("Out of memory", LANGULUS_LOCATION());
+               #endif
+            }
+            handler();
+         }
+      }
+
+      /// Deallocate memory, allocated by any thread's heap                   
+      /// Memory of the current thread is deallocated immediately, while      
+      /// memory of other threads is queued to their heaps, without locking   
+      ///   @param memory - the memory to deallocate, ignored if nullptr      
+      LANGULUS(INLINED)
+      void NewDeleteFree(void* memory) noexcept {
+         if (not memory)
+            return;
+
+         #if LANGULUS_FEATURE(MEMORY_STATISTICS)
+            RecordDeallocation(PoolAllocator::SizeOf(memory));
+            SampleDeallocation(memory);
+         #endif
+
+         const auto owner = PoolAllocator::OwnerOf(memory);
+         const auto heap = CurrentHeap;
+         if (heap and owner == &heap->mPool) LIKELY()
+            heap->mPool.Deallocate(memory);
+         else
+            owner->DeallocateRemote(memory);
+      }
+
+      /// Resize memory, allocated by any thread's heap                       
+      /// Memory of the current thread is resized in place when possible,     
+      /// while memory of other threads is always moved to the current one    
+      ///   @param memory - the memory to resize, allocates if nullptr        
+      ///   @param size - the new number of bytes                             
+      ///   @param alignment - must be the one the memory was allocated with  
+      ///   @return the resized memory, or nullptr if out of memory, in which 
+      ///           case the original memory is left intact                   
+      NOD() LANGULUS(INLINED)
+      void* NewDeleteReallocate(void* memory, const Offset size, const Offset alignment = Alignment) noexcept {
+         if (not memory)
+            return NewDeleteAllocate(size, alignment);
+
+         auto heap = CurrentHeap;
+         if (not heap) UNLIKELY() {
+            heap = AcquireHeap();
+            if (not heap)
+               return nullptr;
+         }
+
+         #if LANGULUS_FEATURE(MEMORY_STATISTICS)
+            const auto oldBytes = PoolAllocator::SizeOf(memory);
+         #endif
+
+         void* result;
+         const auto owner = PoolAllocator::OwnerOf(memory);
+         if (owner == &heap->mPool) LIKELY() {
+            result = heap->mPool.Reallocate(::std::nothrow, memory, size, alignment);
+            #if LANGULUS_FEATURE(MEMORY_STATISTICS)
+               // Nothing else reuses the old slot in the meantime      
+               if (result and result != memory)
+                  SampleDeallocation(memory);
+            #endif
+         }
+         else {
+            // Other heaps can't be touched, so memory is always moved  
+            result = heap->mPool.Allocate(::std::nothrow, size, alignment);
+            if (not result) UNLIKELY()
+               return nullptr;
+
+            const auto capacity = PoolAllocator::SizeOf(memory);
+            ::std::memcpy(result, memory, size < capacity ? size : capacity);
+            #if LANGULUS_FEATURE(MEMORY_STATISTICS)
+               SampleDeallocation(memory);
+            #endif
+            owner->DeallocateRemote(memory);
+         }
+
+         #if LANGULUS_FEATURE(MEMORY_STATISTICS)
+            if (result) LIKELY() {
+               const auto newBytes = PoolAllocator::SizeOf(result);
+               RecordReallocation(oldBytes, newBytes);
+               if (result != memory)
+                  SampleAllocation(result, newBytes);
+            }
+         #endif
+         return result;
+      }
+
+   } // namespace Langulus::Inner
+
+} // namespace Langulus
+
+
+/// Replaces all global new/delete operators with thread-caching ones         
+/// Place it in exactly one source file of your executable - replacement      
+/// operators can't be defined in headers. It does nothing, unless            
+/// LANGULUS_FEATURE_NEWDELETE is enabled                                     
+#if LANGULUS_FEATURE(NEWDELETE)
+   #define LANGULUS_MONOPOLIZE_MEMORY() \
+      LANGULUS_NEWDELETE_API() void* operator new(::std::size_t size) { \
+         return ::Langulus::Inner::NewDeleteAllocateOrThrow(size, ::Langulus::Inner::NewDeleteAlignment); \
+      } \
+      LANGULUS_NEWDELETE_API() void* operator new[](::std::size_t size) { \
+         return ::Langulus::Inner::NewDeleteAllocateOrThrow(size, ::Langulus::Inner::NewDeleteAlignment); \
+      } \
+      LANGULUS_NEWDELETE_API() void* operator new(::std::size_t size, ::std::align_val_t align) { \
+         return ::Langulus::Inner::NewDeleteAllocateOrThrow(size, static_cast<::std::size_t>(align)); \
+      } \
+      LANGULUS_NEWDELETE_API() void* operator new[](::std::size_t size, ::std::align_val_t align) { \
+         return ::Langulus::Inner::NewDeleteAllocateOrThrow(size, static_cast<::std::size_t>(align)); \
+      } \
+      LANGULUS_NEWDELETE_API() void* operator new(::std::size_t size, const ::std::nothrow_t&) noexcept { \
+         return ::Langulus::Inner::NewDeleteAllocate(size, ::Langulus::Inner::NewDeleteAlignment); \
+      } \
+      LANGULUS_NEWDELETE_API() void* operator new[](::std::size_t size, const ::std::nothrow_t&) noexcept { \
+         return ::Langulus::Inner::NewDeleteAllocate(size, ::Langulus::Inner::NewDeleteAlignment); \
+      } \
+      LANGULUS_NEWDELETE_API() void* operator new(::std::size_t size, ::std::align_val_t align, const ::std::nothrow_t&) noexcept { \
+         return ::Langulus::Inner::NewDeleteAllocate(size, static_cast<::std::size_t>(align)); \
+      } \
+      LANGULUS_NEWDELETE_API() void* operator new[](::std::size_t size, ::std::align_val_t align, const ::std::nothrow_t&) noexcept { \
+         return ::Langulus::Inner::NewDeleteAllocate(size, static_cast<::std::size_t>(align)); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete(void* memory) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete[](void* memory) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete(void* memory, ::std::size_t) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete[](void* memory, ::std::size_t) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete(void* memory, ::std::align_val_t) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete[](void* memory, ::std::align_val_t) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete(void* memory, ::std::size_t, ::std::align_val_t) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete[](void* memory, ::std::size_t, ::std::align_val_t) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete(void* memory, const ::std::nothrow_t&) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete[](void* memory, const ::std::nothrow_t&) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete(void* memory, ::std::align_val_t, const ::std::nothrow_t&) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      } \
+      LANGULUS_NEWDELETE_API() void operator delete[](void* memory, ::std::align_val_t, const ::std::nothrow_t&) noexcept { \
+         ::Langulus::Inner::NewDeleteFree(memory); \
+      }
+#else
+   #define LANGULUS_MONOPOLIZE_MEMORY()
+#endif
@@ -0,0 +1,641 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Utilities.hpp"
+#include <new>
+#include <atomic>
+
+#if LANGULUS_OS(WINDOWS)
+   // Declared manually, because windows.h pollutes everything with macros
+   extern "C" {
+      __declspec(dllimport) void* __stdcall VirtualAlloc(void*, ::std::size_t, unsigned long, unsigned long);
+      __declspec(dllimport) int __stdcall VirtualFree(void*, ::std::size_t, unsigned long);
+   }
+#elif LANGULUS_OS(UNIX) or LANGULUS_OS(MACOS)
+   #include <sys/mman.h>
+#else
+   #include <cstdlib>
+#endif
+
+
+namespace Langulus
+{
+
+   class PoolAllocator;
+
+   namespace Inner
+   {
+
+      /// Pool pages are aligned to their size, so that the page of any       
+      /// allocation is found by masking its address                          
+      constexpr Offset PoolPageSize = 64_KiB;
+
+      /// The smallest and the biggest size class, anything bigger gets its   
+      /// own dedicated pages                                                 
+      constexpr Offset PoolMinClass = 16;
+      constexpr Offset PoolMaxClass = 8_KiB;
+      constexpr Count PoolClassCount = CountTrailingZeroes(PoolMaxClass)
+                                     - CountTrailingZeroes(PoolMinClass) + 1;
+      constexpr Count PoolLargeClass = PoolClassCount;
+
+      /// Get the size class index of an allocation                           
+      ///   @param size - the requested number of bytes, up to PoolMaxClass   
+      ///   @return the index of the smallest power-of-two class that fits    
+      NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr Count PoolClassOf(const Offset size) noexcept {
+         return size <= PoolMinClass ? 0
+            : CountTrailingZeroes(Roof2(size)) - CountTrailingZeroes(PoolMinClass);
+      }
+
+      /// Map memory directly from the OS, bypassing new/malloc               
+      ///   @param bytes - number of bytes, must be a multiple of PoolPageSize
+      ///   @return the memory, aligned to PoolPageSize, or nullptr           
+      NOD() LANGULUS(NOINLINE)
+      inline void* AllocatePages(const Offset bytes) noexcept {
+      #if LANGULUS_OS(WINDOWS)
+         // Allocation granularity is 64 KiB on Windows anyways         
+         static_assert(PoolPageSize == 64 * 1024);
+         return VirtualAlloc(nullptr, bytes, 0x1000 | 0x2000, 0x04);
+      #elif LANGULUS_OS(UNIX) or LANGULUS_OS(MACOS)
+         // Over-allocate, and trim the misaligned ends                 
+         const auto memory = mmap(nullptr, bytes + PoolPageSize,
+            PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+         if (memory == MAP_FAILED)
+            return nullptr;
+
+         const auto start = reinterpret_cast<Pointer>(memory);
+         const auto aligned = (start + PoolPageSize - 1) & ~(PoolPageSize - 1);
+         if (aligned != start)
+            munmap(memory, aligned - start);
+         if (aligned + bytes != start + bytes + PoolPageSize) {
+            munmap(reinterpret_cast<void*>(aligned + bytes),
+               start + PoolPageSize - aligned);
+         }
+         return reinterpret_cast<void*>(aligned);
+      #else
+         return ::std::aligned_alloc(PoolPageSize, bytes);
+      #endif
+      }
+
+      /// Return memory, mapped by AllocatePages, to the OS                   
+      ///   @param memory - the memory to free                                
+      ///   @param bytes - the number of bytes, same as when allocated        
+      LANGULUS(NOINLINE)
+      inline void FreePages(void* memory, [[maybe_unused]] const Offset bytes) noexcept {
+      #if LANGULUS_OS(WINDOWS)
+         VirtualFree(memory, 0, 0x8000);
+      #elif LANGULUS_OS(UNIX) or LANGULUS_OS(MACOS)
+         munmap(memory, bytes);
+      #else
+         ::std::free(memory);
+      #endif
+      }
+
+      ///                                                                     
+      /// Minimal lock for short critical sections, that never allocates      
+      ///                                                                     
+      class SpinLock {
+         ::std::atomic_flag mFlag;
+
+      public:
+         LANGULUS(INLINED)
+         void Lock() noexcept {
+            while (mFlag.test_and_set(::std::memory_order_acquire)) {
+               while (mFlag.test(::std::memory_order_relaxed))
+                  mFlag.wait(true, ::std::memory_order_relaxed);
+            }
+         }
+
+         LANGULUS(INLINED)
+         void Unlock() noexcept {
+            mFlag.clear(::std::memory_order_release);
+            mFlag.notify_one();
+         }
+      };
+
+      /// A free slot inside a pool page                                      
+      struct PoolSlot {
+         PoolSlot* mNext;
+      };
+
+      ///                                                                     
+      /// Header at the start of every pool page                              
+      ///                                                                     
+      struct alignas(Alignment) PoolPage {
+         // The pool that owns the page                                 
+         PoolAllocator* mOwner;
+         // Neighbours in the owner's list of pages with free slots, or 
+         // the next page in a list of empty pages                      
+         PoolPage* mPrev;
+         PoolPage* mNext;
+         union {
+            // Slots that were freed, and can be reused                 
+            PoolSlot* mFreeList;
+            // Where the mapping of a large page starts - the header is 
+            // further in, if the allocation is page-aligned or more    
+            void* mMapping;
+         };
+         // The first slot that was never used, or the start of the     
+         // allocation in large pages                                   
+         Pointer mUncarved;
+         // Slot size, or the number of mapped bytes for large pages    
+         Offset mSize;
+         // Number of allocated slots, and the maximum number of slots  
+         ::std::uint32_t mUsed;
+         ::std::uint32_t mCapacity;
+         // Size class index, or PoolLargeClass                         
+         Count mClass;
+
+         /// Get the page that contains an allocation                         
+         /// No allocation starts at a page boundary, because the header is   
+         /// always before it - except for those aligned to a page or more,   
+         /// which start right after their header's page. Stepping back a     
+         /// byte before masking finds the header in both cases               
+         NOD() LANGULUS(ALWAYS_INLINED)
+         static PoolPage* Of(const void* memory) noexcept {
+            return reinterpret_cast<PoolPage*>(
+               (reinterpret_cast<Pointer>(memory) - 1) & ~(PoolPageSize - 1));
+         }
+      };
+
+      static_assert(Alignment <= PoolMaxClass,
+         "Allocations with the default alignment must fit in a size class, "
+         "or each of them would map pages of its own");
+
+   } // namespace Langulus::Inner
+
+
+   ///                                                                        
+   ///   Central cache of empty pool pages                                    
+   ///                                                                        
+   /// Pools that share a cache hand their excess empty pages to it, and take 
+   /// pages from it before mapping new ones - always in batches, so that the 
+   /// lock is rarely touched. Pages above the limit are returned to the OS   
+   /// Thread-safe                                                            
+   ///                                                                        
+   class PageCache {
+      Inner::SpinLock mLock;
+      // Empty pages, linked via PoolPage::mNext                        
+      Inner::PoolPage* mPages {};
+      // Number of pages in the cache                                   
+      Count mCount {};
+      // Maximum number of pages to keep                                
+      Count mLimit;
+
+   public:
+      static constexpr Count DefaultLimit = 64;
+
+      PageCache(const PageCache&) = delete;
+      PageCache& operator = (const PageCache&) = delete;
+
+      /// Create a cache                                                      
+      ///   @param limit - maximum number of empty pages to keep              
+      LANGULUS(INLINED)
+      constexpr explicit PageCache(const Count limit = DefaultLimit) noexcept
+         : mLimit {limit} {}
+
+      LANGULUS(INLINED)
+      constexpr ~PageCache() {
+         while (mPages) {
+            const auto next = mPages->mNext;
+            Inner::FreePages(mPages, Inner::PoolPageSize);
+            mPages = next;
+         }
+      }
+
+      /// Take a batch of pages                                               
+      ///   @param pages - [out] the taken pages, linked via mNext            
+      ///   @param count - maximum number of pages to take                    
+      ///   @return the number of pages taken                                 
+      NOD() LANGULUS(NOINLINE)
+      Count Take(Inner::PoolPage*& pages, const Count count) noexcept {
+         Count taken = 0;
+         pages = nullptr;
+         mLock.Lock();
+         while (mPages and taken < count) {
+            const auto page = mPages;
+            mPages = page->mNext;
+            page->mNext = pages;
+            pages = page;
+            ++taken;
+         }
+         mCount -= taken;
+         mLock.Unlock();
+         return taken;
+      }
+
+      /// Give a batch of pages, that are no longer used                      
+      ///   @param pages - the pages, linked via mNext                        
+      LANGULUS(NOINLINE)
+      void Give(Inner::PoolPage* pages) noexcept {
+         mLock.Lock();
+         while (pages and mCount < mLimit) {
+            const auto next = pages->mNext;
+            pages->mNext = mPages;
+            mPages = pages;
+            pages = next;
+            ++mCount;
+         }
+         mLock.Unlock();
+
+         // Whatever didn't fit goes back to the OS, outside the lock   
+         while (pages) {
+            const auto next = pages->mNext;
+            Inner::FreePages(pages, Inner::PoolPageSize);
+            pages = next;
+         }
+      }
+
+      /// Get the number of pages in the cache                                
+      NOD() LANGULUS(INLINED)
+      Count GetCount() const noexcept {
+         return mCount;
+      }
+   };
+
+
+   ///                                                                        
+   ///   Size class pool allocator                                            
+   ///                                                                        
+   /// Rounds requests up to power-of-two size classes via Roof2, from 16     
+   /// bytes to 8 KiB, and carves them from 64 KiB pages, mapped directly     
+   /// from the OS. Each page holds a single class, with its own intrusive    
+   /// free list, and the page of any allocation is found by masking its      
+   /// address, so deallocation needs no size, and no lookup.                 
+   /// Bigger requests get dedicated pages. A few empty pages are kept as     
+   /// spares, so that allocations bouncing at a page boundary don't map and  
+   /// unmap each time - the rest go to a shared PageCache if any, or         
+   /// straight back to the OS                                                
+   /// Every slot is aligned to its class size                                
+   /// Not thread-safe, except for DeallocateRemote - use one pool per thread 
+   ///                                                                        
+   class PoolAllocator {
+      // Pages with at least one free slot, for each class              
+      Inner::PoolPage* mAvailable[Inner::PoolClassCount] {};
+      // Empty pages, kept to avoid thrashing, linked via mNext         
+      Inner::PoolPage* mSpares {};
+      Count mSpareCount {};
+      // Where to give excess empty pages to, and take new ones from    
+      PageCache* mCache {};
+      // Number of bytes, mapped from the OS                            
+      Offset mReserved {};
+      // Slots, that were deallocated by other threads, waiting to be   
+      // collected by the owner - kept apart, because others write it   
+      alignas(CacheLine) ::std::atomic<Inner::PoolSlot*> mRemote {};
+
+   public:
+      static constexpr Count SpareLimit = 4;
+
+      PoolAllocator(const PoolAllocator&) = delete;
+      PoolAllocator(PoolAllocator&&) = delete;
+      PoolAllocator& operator = (const PoolAllocator&) = delete;
+      PoolAllocator& operator = (PoolAllocator&&) = delete;
+
+      /// Create a pool - no memory is mapped until needed                    
+      ///   @param cache - optional central cache to share empty pages via    
+      LANGULUS(INLINED)
+      constexpr explicit PoolAllocator(PageCache* cache = nullptr) noexcept
+         : mCache {cache} {}
+
+      /// All allocations must be deallocated before the pool is destroyed,   
+      /// otherwise their pages are leaked                                    
+      LANGULUS(INLINED)
+      ~PoolAllocator() {
+         Collect();
+         Trim();
+      }
+
+      /// Allocate uninitialized bytes                                        
+      ///   @param size - number of bytes to allocate                         
+      ///   @param alignment - the alignment, must be a power-of-two          
+      ///   @return the allocated memory, never nullptr                       
+      ///   @attention throws Except::Allocate if out of memory               
+      NOD() LANGULUS(INLINED)
+      void* Allocate(const Size size, const Offset alignment = Alignment) {
+         const auto memory = Allocate(::std::nothrow, size, alignment);
+         if (not memory) UNLIKELY()
+            Throw<Except::Allocate>("Out of memory", LANGULUS_LOCATION());
+         return memory;
+      }
+
+      /// Allocate uninitialized bytes, without throwing                      
+      ///   @param size - number of bytes to allocate                         
+      ///   @param alignment - the alignment, must be a power-of-two          
+      ///   @return the allocated memory, or nullptr if out of memory         
+      NOD() LANGULUS(INLINED)
+      void* Allocate(const ::std::nothrow_t&, Offset size, const Offset alignment = Alignment) noexcept {
+         // Slots are aligned to their class size                       
+         if (alignment > size) UNLIKELY()
+            size = alignment;
+         if (size > Inner::PoolMaxClass) UNLIKELY()
+            return AllocateLarge(size, alignment);
+
+         const auto index = Inner::PoolClassOf(size);
+         auto page = mAvailable[index];
+         if (not page) UNLIKELY() {
+            page = Refill(index);
+            if (not page)
+               return nullptr;
+         }
+
+         auto slot = page->mFreeList;
+         if (slot)
+            page->mFreeList = slot->mNext;
+         else {
+            slot = reinterpret_cast<Inner::PoolSlot*>(page->mUncarved);
+            page->mUncarved += page->mSize;
+         }
+
+         if (++page->mUsed == page->mCapacity)
+            Unlink(page);
+         return slot;
+      }
+
+      /// Deallocate memory, that was allocated by this pool, from the        
+      /// thread that owns the pool                                           
+      ///   @param memory - the memory to deallocate, ignored if nullptr      
+      ///   @attention in safe mode, throws Except::Deallocate if memory      
+      ///              was allocated by another pool                          
+      LANGULUS(INLINED)
+      void Deallocate(void* memory) noexcept(not LANGULUS(SAFE)) {
+         if (not memory)
+            return;
+
+         const auto page = Inner::PoolPage::Of(memory);
+         #if LANGULUS(SAFE)
+            if (page->mOwner != this)
+               Throw<Except::Deallocate>("Memory is not owned by this pool", LANGULUS_LOCATION());
+         #endif
+
+         if (page->mClass == Inner::PoolLargeClass) UNLIKELY() {
+            mReserved -= page->mSize;
+            Inner::FreePages(page->mMapping, page->mSize);
+            return;
+         }
+
+         IF_LANGULUS_PARANOID(::std::memset(memory, 0, page->mSize));
+         const auto slot = static_cast<Inner::PoolSlot*>(memory);
+         slot->mNext = page->mFreeList;
+         page->mFreeList = slot;
+
+         const bool wasFull = page->mUsed == page->mCapacity;
+         if (--page->mUsed == 0) {
+            if (not wasFull)
+               Unlink(page);
+            Retire(page);
+         }
+         else if (wasFull)
+            Link(page);
+      }
+
+      /// Resize memory, that was allocated by this pool, from the thread     
+      /// that owns the pool                                                  
+      ///   @param memory - the memory to resize, allocates if nullptr        
+      ///   @param size - the new number of bytes                             
+      ///   @param alignment - must be the one the memory was allocated with  
+      ///   @return the resized memory, never nullptr                         
+      ///   @attention throws Except::Allocate if out of memory, in which     
+      ///              case the original memory is left intact                
+      NOD() LANGULUS(INLINED)
+      void* Reallocate(void* memory, const Size size, const Offset alignment = Alignment) {
+         const auto result = Reallocate(::std::nothrow, memory, size, alignment);
+         if (not result) UNLIKELY()
+            Throw<Except::Allocate>("Out of memory", LANGULUS_LOCATION());
+         return result;
+      }
+
+      /// Resize memory, that was allocated by this pool, from the thread     
+      /// that owns the pool, without throwing                                
+      /// The memory stays in place, if the new size still rounds to the      
+      /// slot it occupies, otherwise the contents are moved to a new slot    
+      ///   @param memory - the memory to resize, allocates if nullptr        
+      ///   @param size - the new number of bytes                             
+      ///   @param alignment - must be the one the memory was allocated with  
+      ///   @return the resized memory, or nullptr if out of memory, in which 
+      ///           case the original memory is left intact                   
+      NOD() LANGULUS(INLINED)
+      void* Reallocate(const ::std::nothrow_t&, void* memory, const Offset size, const Offset alignment = Alignment) noexcept(not LANGULUS(SAFE)) {
+         if (not memory)
+            return Allocate(::std::nothrow, size, alignment);
+
+         // Shrinking to less than half would waste most of the slot    
+         const auto capacity = SizeOf(memory);
+         const auto needed = alignment > size ? alignment : size;
+         if (needed <= capacity and needed > capacity / 2)
+            return memory;
+
+         const auto result = Allocate(::std::nothrow, size, alignment);
+         if (not result) UNLIKELY()
+            return nullptr;
+
+         ::std::memcpy(result, memory, size < capacity ? size : capacity);
+         Deallocate(memory);
+         return result;
+      }
+
+      /// Deallocate memory, that was allocated by this pool, from any        
+      /// thread. The memory is only queued, and is actually deallocated      
+      /// when the owner collects it                                          
+      ///   @param memory - the memory to deallocate, must not be nullptr     
+      LANGULUS(INLINED)
+      void DeallocateRemote(void* memory) noexcept {
+         const auto slot = static_cast<Inner::PoolSlot*>(memory);
+         slot->mNext = mRemote.load(::std::memory_order_relaxed);
+         while (not mRemote.compare_exchange_weak(slot->mNext, slot,
+            ::std::memory_order_release, ::std::memory_order_relaxed));
+      }
+
+      /// Deallocate everything that was queued by DeallocateRemote           
+      /// Done automatically when the pool runs out of pages                  
+      LANGULUS(NOINLINE)
+      void Collect() noexcept {
+         auto slot = mRemote.exchange(nullptr, ::std::memory_order_acquire);
+         while (slot) {
+            const auto next = slot->mNext;
+            Deallocate(slot);
+            slot = next;
+         }
+      }
+
+      /// Release all spare pages                                             
+      LANGULUS(NOINLINE)
+      void Trim() noexcept {
+         mReserved -= mSpareCount * Inner::PoolPageSize;
+         GiveAway(mSpares);
+         mSpares = nullptr;
+         mSpareCount = 0;
+      }
+
+      /// Get the usable size of an allocation                                
+      ///   @param memory - the allocation, must not be nullptr               
+      ///   @return the size of its class, which is at least the size that    
+      ///           was requested                                             
+      NOD() LANGULUS(INLINED)
+      static Offset SizeOf(const void* memory) noexcept {
+         const auto page = Inner::PoolPage::Of(memory);
+         return page->mClass == Inner::PoolLargeClass
+            ? reinterpret_cast<Pointer>(page->mMapping) + page->mSize - page->mUncarved
+            : page->mSize;
+      }
+
+      /// Get the pool that made an allocation                                
+      ///   @param memory - the allocation, must not be nullptr               
+      ///   @return the pool                                                  
+      NOD() LANGULUS(INLINED)
+      static PoolAllocator* OwnerOf(const void* memory) noexcept {
+         return Inner::PoolPage::Of(memory)->mOwner;
+      }
+
+      /// Get the number of bytes currently mapped from the OS                
+      NOD() LANGULUS(INLINED)
+      Offset GetReserved() const noexcept {
+         return mReserved;
+      }
+
+   private:
+      /// Get a page with free slots for a size class, after collecting       
+      /// remote deallocations, reusing a spare page, taking a batch of       
+      /// pages from the cache, or mapping a new one - in that order          
+      NOD() LANGULUS(NOINLINE)
+      Inner::PoolPage* Refill(const Count index) noexcept {
+         if (mRemote.load(::std::memory_order_relaxed)) {
+            Collect();
+            if (mAvailable[index])
+               return mAvailable[index];
+         }
+
+         if (not mSpares and mCache) {
+            mSpareCount = mCache->Take(mSpares, SpareLimit / 2);
+            mReserved += mSpareCount * Inner::PoolPageSize;
+         }
+
+         void* memory = mSpares;
+         if (memory) {
+            mSpares = mSpares->mNext;
+            --mSpareCount;
+         }
+         else {
+            memory = Inner::AllocatePages(Inner::PoolPageSize);
+            if (not memory)
+               return nullptr;
+            mReserved += Inner::PoolPageSize;
+         }
+
+         // The first slot is aligned to the class size, which is free, 
+         // because the header never fits in the space it wastes        
+         const auto size = Inner::PoolMinClass << index;
+         const auto start = (sizeof(Inner::PoolPage) + size - 1) & ~(size - 1);
+         const auto page = new (memory) Inner::PoolPage {
+            this, nullptr, nullptr, nullptr,
+            reinterpret_cast<Pointer>(memory) + start, size, 0,
+            static_cast<::std::uint32_t>((Inner::PoolPageSize - start) / size),
+            index
+         };
+         Link(page);
+         return page;
+      }
+
+      /// Map dedicated pages for a big allocation                            
+      /// The allocation starts in the same page as the header, so that the   
+      /// header can be found by masking. Allocations aligned to a page or    
+      /// more can't fit there - the mapping is made bigger by the alignment  
+      /// instead, and they start at the first aligned page boundary, that    
+      /// leaves a page for the header before it                              
+      NOD() LANGULUS(NOINLINE)
+      void* AllocateLarge(const Offset size, const Offset alignment) noexcept {
+         const auto start = alignment < Inner::PoolPageSize
+            ? (sizeof(Inner::PoolPage) + alignment - 1) & ~(alignment - 1)
+            : alignment;
+         if (size > OffsetMax - start - Inner::PoolPageSize)
+            return nullptr;
+
+         const auto bytes = (start + size + Inner::PoolPageSize - 1)
+            & ~(Inner::PoolPageSize - 1);
+         const auto memory = Inner::AllocatePages(bytes);
+         if (not memory)
+            return nullptr;
+
+         // Pages are aligned only to their size, so find the aligned   
+         // start within the extra space                                
+         const auto mapping = reinterpret_cast<Pointer>(memory);
+         const auto allocation = alignment < Inner::PoolPageSize
+            ? mapping + start
+            : (mapping + Inner::PoolPageSize + alignment - 1) & ~(alignment - 1);
+
+         mReserved += bytes;
+         const auto page = new (reinterpret_cast<void*>(
+            alignment < Inner::PoolPageSize ? mapping : allocation - Inner::PoolPageSize
+         )) Inner::PoolPage {
+            this, nullptr, nullptr, nullptr,
+            allocation, bytes, 1, 1,
+            Inner::PoolLargeClass
+         };
+         page->mMapping = memory;
+         return reinterpret_cast<void*>(page->mUncarved);
+      }
+
+      /// Keep an empty page as a spare. When there are too many spares,      
+      /// give half of them away in one batch                                 
+      LANGULUS(INLINED)
+      void Retire(Inner::PoolPage* page) noexcept {
+         page->mNext = mSpares;
+         mSpares = page;
+         if (++mSpareCount <= SpareLimit)
+            return;
+
+         auto last = mSpares;
+         for (Count i = 1; i < SpareLimit / 2; ++i)
+            last = last->mNext;
+
+         const auto excess = last->mNext;
+         last->mNext = nullptr;
+         mReserved -= (mSpareCount - SpareLimit / 2) * Inner::PoolPageSize;
+         mSpareCount = SpareLimit / 2;
+         GiveAway(excess);
+      }
+
+      /// Give empty pages to the cache, or to the OS if there's no cache     
+      LANGULUS(NOINLINE)
+      void GiveAway(Inner::PoolPage* pages) noexcept {
+         if (mCache) {
+            if (pages)
+               mCache->Give(pages);
+            return;
+         }
+
+         while (pages) {
+            const auto next = pages->mNext;
+            Inner::FreePages(pages, Inner::PoolPageSize);
+            pages = next;
+         }
+      }
+
+      /// Insert a page at the front of the available list of its class       
+      LANGULUS(INLINED)
+      void Link(Inner::PoolPage* page) noexcept {
+         auto& head = mAvailable[page->mClass];
+         page->mPrev = nullptr;
+         page->mNext = head;
+         if (head)
+            head->mPrev = page;
+         head = page;
+      }
+
+      /// Remove a page from the available list of its class                  
+      LANGULUS(INLINED)
+      void Unlink(Inner::PoolPage* page) noexcept {
+         if (page->mPrev)
+            page->mPrev->mNext = page->mNext;
+         else
+            mAvailable[page->mClass] = page->mNext;
+         if (page->mNext)
+            page->mNext->mPrev = page->mPrev;
+      }
+   };
+
+} // namespace Langulus
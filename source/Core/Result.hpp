@@ -0,0 +1,165 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Exceptions.hpp"
+#include <expected>
+#include <utility>
+
+
+namespace Langulus
+{
+
+   class Error;
+
+   namespace Inner
+   {
+      /// Throw an error as the exception type it was made from               
+      template<CT::Exception E>
+      [[noreturn]] LANGULUS(NOINLINE) void ThrowError(const Error&);
+   }
+
+   ///                                                                        
+   ///   Compact error                                                        
+   ///                                                                        
+   /// Carries the category of an exception type, without throwing it. Like   
+   /// exceptions, it has a message and a location only in debug builds, so   
+   /// in release builds it is just a category and a pointer to a function,   
+   /// that throws the original exception type, if ever needed                
+   ///                                                                        
+   class Error {
+      ErrorCategory mCategory;
+      void (*mThrow)(const Error&);
+
+      #if LANGULUS(DEBUG)
+         Token mMessage;
+         Token mLocation;
+      #endif
+
+   public:
+      Error() = delete;
+
+      /// Make an error from an exception type                                
+      ///   @param message - custom message about the error                   
+      ///   @param location - location of error, see LANGULUS_LOCATION()      
+      template<CT::Exception E> NOD() LANGULUS(INLINED)
+      static constexpr Error From(
+         [[maybe_unused]] const char* message = "<no information provided>",
+         [[maybe_unused]] const char* location = "<unknown location>"
+      ) noexcept {
+         return Error {E::Category, &Inner::ThrowError<E>
+         #if LANGULUS(DEBUG)
+            , message, location
+         #endif
+         };
+      }
+
+      /// Check if the error was made from an exception type                  
+      template<CT::Exception E> NOD() LANGULUS(INLINED)
+      constexpr bool Is() const noexcept {
+         return mCategory == E::Category;
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr ErrorCategory GetCategory() const noexcept {
+         return mCategory;
+      }
+
+      #if LANGULUS(DEBUG)
+         NOD() LANGULUS(INLINED)
+         constexpr const Token& GetMessage() const noexcept {
+            return mMessage;
+         }
+
+         NOD() LANGULUS(INLINED)
+         constexpr const Token& GetLocation() const noexcept {
+            return mLocation;
+         }
+      #endif
+
+      /// Throw the exception type the error was made from                    
+      [[noreturn]] LANGULUS(INLINED)
+      void Throw() const {
+         mThrow(*this);
+         ::std::unreachable();
+      }
+
+      constexpr bool operator == (const Error& rhs) const noexcept {
+         return mCategory == rhs.mCategory;
+      }
+
+   private:
+      #if LANGULUS(DEBUG)
+         LANGULUS(INLINED)
+         constexpr Error(
+            const ErrorCategory category, void (*thrower)(const Error&),
+            const char* message, const char* location
+         ) noexcept
+            : mCategory {category}
+            , mThrow {thrower}
+            , mMessage {message}
+            , mLocation {location} {}
+      #else
+         LANGULUS(INLINED)
+         constexpr Error(const ErrorCategory category, void (*thrower)(const Error&)) noexcept
+            : mCategory {category}
+            , mThrow {thrower} {}
+      #endif
+   };
+
+   namespace Inner
+   {
+      template<CT::Exception E>
+      [[noreturn]] LANGULUS(NOINLINE) void ThrowError(const Error& error) {
+         #if LANGULUS(DEBUG)
+            Throw<E>(error.GetMessage().data(), error.GetLocation().data());
+         #else
+            (void) error;
+            Throw<E>();
+         #endif
+      }
+   }
+
+   /// A value, or the error that prevented it, returned instead of throwing  
+   /// Failure paths stay cheap, and don't prevent inlining                   
+   ///   @tparam T - the value type, can be void                              
+   ///   @tparam E - the error type, Error by default                         
+   template<class T, class E = Error>
+   using Result = ::std::expected<T, E>;
+
+   /// Fail with an error made from an exception type                         
+   ///   @param message - custom message about the error                      
+   ///   @param location - location of error, see LANGULUS_LOCATION()         
+   ///   @return the failure, convertible to any Result                       
+   template<CT::Exception E> NOD() LANGULUS(INLINED)
+   constexpr ::std::unexpected<Error> Fail(
+      const char* message = "<no information provided>",
+      const char* location = "<unknown location>"
+   ) noexcept {
+      return ::std::unexpected<Error> {Error::From<E>(message, location)};
+   }
+
+   /// Get the value of a result, or throw its error as the exception type it 
+   /// was made from, bridging Result and exception-based code                
+   ///   @param result - the result to unwrap                                 
+   ///   @return the value - a reference for lvalue results, a moved value    
+   ///           for rvalue results, nothing for Result<void>                 
+   template<class T> LANGULUS(INLINED)
+   constexpr decltype(auto) Unwrap(T&& result) requires requires { result.error().Throw(); } {
+      if (not result.has_value()) UNLIKELY()
+         result.error().Throw();
+
+      using V = typename Deref<T>::value_type;
+      if constexpr (CT::Void<V>)
+         return;
+      else if constexpr (::std::is_lvalue_reference_v<T>)
+         return *result;
+      else
+         return V {::std::move(*result)};
+   }
+
+} // namespace Langulus
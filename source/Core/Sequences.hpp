@@ -6,7 +6,8 @@
 /// SPDX-License-Identifier: MIT                                              
 ///                                                                           
 #pragma once
-#include "Common.hpp"
+#include "Exceptions.hpp"
+#include <array>
 
 
 namespace Langulus
@@ -26,6 +27,22 @@ namespace Langulus
          return noexcept(Fake<LAMBDA&&>().template operator() <0> ());
       }
 
+      /// Call a single instantiation of the generator                        
+      template<class R, class F, Offset IDX> LANGULUS(INLINED)
+      static constexpr R Invoke(F& generator) noexcept(Noexcept<F&>()) {
+         return generator.template operator() <IDX> ();
+      }
+
+      /// Make a table of all instantiations of the generator                 
+      template<class R, class F, Offset...IDX>
+      static consteval auto MakeTable(ExpandedSequence<IDX...>) noexcept {
+         return ::std::array<R(*)(F&), END> {&Invoke<R, F, IDX>...};
+      }
+
+      /// Instantiations of the generator, indexed at runtime                 
+      template<class R, class F>
+      static constexpr auto Table = MakeTable<R, F>(::std::make_integer_sequence<Offset, END> {});
+
    public:
       static constexpr Offset Size = END;
       static constexpr bool Empty  = END == 0;
@@ -46,6 +63,49 @@ namespace Langulus
             (generator.template operator() <IDX> (), ...);
          }(Expand);
       }
+
+      /// Iterate through each index in the sequence using generator pattern, 
+      /// until the generator returns false                                   
+      ///   @param generator - a templated lambda function, returning bool    
+      ///   @return true if all indices were iterated                         
+      /// Example use:                                                        
+      ///   const bool allZero = Sequence<Size>::ForEachBreak(                
+      ///      [&]<Offset IDX>() noexcept {                                   
+      ///         return mArray[IDX] == 0;                                    
+      ///      });                                                            
+      template<class LAMBDA> LANGULUS(INLINED)
+      static constexpr bool ForEachBreak(LAMBDA&& generator) noexcept(Noexcept<LAMBDA>()) {
+         return [&]<Offset...IDX>(ExpandedSequence<IDX...>) noexcept(Noexcept<LAMBDA>()) {
+            return (static_cast<bool>(generator.template operator() <IDX> ()) and ...);
+         }(Expand);
+      }
+
+      /// Call the generator instantiation for an index, that is known only   
+      /// at runtime, via a single indirect call through a table of all       
+      /// instantiations, instead of comparing against each index             
+      ///   @param index - the index, must be less than END                   
+      ///   @param generator - a templated lambda function, all               
+      ///                      instantiations must return the same type       
+      ///   @return whatever the generator returns                            
+      ///   @attention throws Except::OutOfRange in safe mode, if index is    
+      ///              out of range - the behavior is undefined otherwise     
+      /// Example use:                                                        
+      ///   Sequence<TypeCount>::Dispatch(typeIndex, [&]<Offset IDX>() {      
+      ///      return Process<IDX>(data);                                    
+      ///   });                                                               
+      template<class LAMBDA> NOD() LANGULUS(INLINED)
+      static constexpr decltype(auto) Dispatch(const Offset index, LAMBDA&& generator)
+      noexcept(Noexcept<LAMBDA>() and not LANGULUS(SAFE)) requires (END > 0) {
+         using F = Deref<LAMBDA>;
+         using R = decltype(Fake<F&>().template operator() <0> ());
+
+         #if LANGULUS(SAFE)
+            if (index >= END)
+               Throw<Except::OutOfRange>("Sequence index out of range", LANGULUS_LOCATION());
+         #endif
+
+         return Table<R, F>[index](generator);
+      }
    };
 
 } // namespace Langulus
@@ -0,0 +1,1319 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Utilities.hpp"
+#include <cmath>
+#include <bit>
+
+#if LANGULUS_SIMD(AVX) or LANGULUS_SIMD(AVX2) or LANGULUS_SIMD(AVX512)
+   #include <immintrin.h>
+#elif LANGULUS_SIMD(SSE2)
+   #include <emmintrin.h>
+#elif LANGULUS_SIMD(NEON)
+   #include <arm_neon.h>
+#endif
+
+
+namespace Langulus
+{
+
+   template<CT::BuiltinNumber T, Count N>
+   class Simd;
+
+   ///                                                                        
+   ///   Result of comparing vectors                                          
+   ///                                                                        
+   /// Bit i is set, if the comparison is true for lane i                     
+   ///                                                                        
+   template<Count N>
+   class SimdMask {
+      static_assert(N > 0 and N <= 64, "Masks have up to 64 lanes");
+      ::std::uint64_t mBits {};
+
+   public:
+      static constexpr ::std::uint64_t Full = N == 64
+         ? ~::std::uint64_t {0} : (::std::uint64_t {1} << N) - 1;
+
+      constexpr SimdMask() noexcept = default;
+
+      /// Create a mask from bits, ignoring the ones beyond N                 
+      LANGULUS(INLINED)
+      explicit constexpr SimdMask(const ::std::uint64_t bits) noexcept
+         : mBits {bits & Full} {}
+
+      NOD() LANGULUS(INLINED)
+      constexpr ::std::uint64_t GetBits() const noexcept {
+         return mBits;
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr bool operator [] (const Offset lane) const noexcept {
+         return (mBits >> lane) & 1;
+      }
+
+      /// Check if any lane is set                                            
+      NOD() LANGULUS(INLINED)
+      constexpr bool Any() const noexcept {
+         return mBits != 0;
+      }
+
+      /// Check if all lanes are set                                          
+      NOD() LANGULUS(INLINED)
+      constexpr bool All() const noexcept {
+         return mBits == Full;
+      }
+
+      /// Check if no lane is set                                             
+      NOD() LANGULUS(INLINED)
+      constexpr bool None() const noexcept {
+         return mBits == 0;
+      }
+
+      /// Count the set lanes                                                 
+      NOD() LANGULUS(INLINED)
+      constexpr Count CountSet() const noexcept {
+         return static_cast<Count>(::std::popcount(mBits));
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr SimdMask operator & (const SimdMask& lhs, const SimdMask& rhs) noexcept {
+         return SimdMask {lhs.mBits & rhs.mBits};
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr SimdMask operator | (const SimdMask& lhs, const SimdMask& rhs) noexcept {
+         return SimdMask {lhs.mBits | rhs.mBits};
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr SimdMask operator ^ (const SimdMask& lhs, const SimdMask& rhs) noexcept {
+         return SimdMask {lhs.mBits ^ rhs.mBits};
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr SimdMask operator ~ () const noexcept {
+         return SimdMask {~mBits};
+      }
+
+      constexpr bool operator == (const SimdMask&) const noexcept = default;
+   };
+
+   namespace Inner
+   {
+
+      /// Vectors are aligned to their size, so that they can be loaded in a  
+      /// single aligned instruction - as long as it is a power-of-two        
+      template<class T, Count N>
+      constexpr Offset SimdAlignment = ::std::has_single_bit(sizeof(T) * N)
+         ? sizeof(T) * N : alignof(T);
+
+      /// Native operations on registers of a given size                      
+      /// Only lanes of 4 and 8 bytes are native, any other vector falls      
+      /// back to loops, that compilers usually vectorize on their own. Any   
+      /// operation that a backend lacks falls back to a loop, too            
+      template<class T, Offset BYTES>
+      struct SimdBackend {};
+
+      template<class T>
+      concept SimdLane = CT::BuiltinNumber<T> and (sizeof(T) == 4 or sizeof(T) == 8);
+
+      /// Register types are picked via functions, because they lose their    
+      /// attributes, when used as template arguments                         
+   #if LANGULUS_SIMD(SSE2)
+      template<class T> NOD()
+      auto SimdRegister16() noexcept {
+         if constexpr (CT::Exact<T, float>)       return __m128 {};
+         else if constexpr (CT::Exact<T, double>) return __m128d {};
+         else return __m128i {};
+      }
+   #endif
+
+   #if LANGULUS_SIMD(AVX)
+      template<class T> NOD()
+      auto SimdRegister32() noexcept {
+         if constexpr (CT::Exact<T, float>)       return __m256 {};
+         else if constexpr (CT::Exact<T, double>) return __m256d {};
+         else return __m256i {};
+      }
+   #endif
+
+   #if LANGULUS_SIMD(AVX512)
+      template<class T> NOD()
+      auto SimdRegister64() noexcept {
+         if constexpr (CT::Exact<T, float>)       return __m512 {};
+         else if constexpr (CT::Exact<T, double>) return __m512d {};
+         else return __m512i {};
+      }
+   #endif
+
+   #if LANGULUS_SIMD(SSE2)
+      ///                                                                     
+      /// 128-bit registers on x86                                            
+      ///                                                                     
+      template<SimdLane T>
+      struct SimdBackend<T, 16> {
+         using R = decltype(SimdRegister16<T>());
+         static constexpr bool F32 = CT::Exact<T, float>;
+         static constexpr bool F64 = CT::Exact<T, double>;
+         static constexpr bool Wide = sizeof(T) == 8;
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Load(const T* p) noexcept {
+            if constexpr (F32)      return _mm_loadu_ps(p);
+            else if constexpr (F64) return _mm_loadu_pd(p);
+            else return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R LoadAligned(const T* p) noexcept {
+            if constexpr (F32)      return _mm_load_ps(p);
+            else if constexpr (F64) return _mm_load_pd(p);
+            else return _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static void Store(T* p, const R r) noexcept {
+            if constexpr (F32)      _mm_storeu_ps(p, r);
+            else if constexpr (F64) _mm_storeu_pd(p, r);
+            else _mm_storeu_si128(reinterpret_cast<__m128i*>(p), r);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static void StoreAligned(T* p, const R r) noexcept {
+            if constexpr (F32)      _mm_store_ps(p, r);
+            else if constexpr (F64) _mm_store_pd(p, r);
+            else _mm_store_si128(reinterpret_cast<__m128i*>(p), r);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Add(const R a, const R b) noexcept {
+            if constexpr (F32)       return _mm_add_ps(a, b);
+            else if constexpr (F64)  return _mm_add_pd(a, b);
+            else if constexpr (Wide) return _mm_add_epi64(a, b);
+            else return _mm_add_epi32(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Sub(const R a, const R b) noexcept {
+            if constexpr (F32)       return _mm_sub_ps(a, b);
+            else if constexpr (F64)  return _mm_sub_pd(a, b);
+            else if constexpr (Wide) return _mm_sub_epi64(a, b);
+            else return _mm_sub_epi32(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Mul(const R a, const R b) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm_mul_ps(a, b);
+            else               return _mm_mul_pd(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Div(const R a, const R b) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm_div_ps(a, b);
+            else               return _mm_div_pd(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Min(const R a, const R b) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm_min_ps(a, b);
+            else               return _mm_min_pd(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Max(const R a, const R b) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm_max_ps(a, b);
+            else               return _mm_max_pd(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Sqrt(const R a) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm_sqrt_ps(a);
+            else               return _mm_sqrt_pd(a);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R And(const R a, const R b) noexcept requires CT::BuiltinInteger<T> {
+            return _mm_and_si128(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Or(const R a, const R b) noexcept requires CT::BuiltinInteger<T> {
+            return _mm_or_si128(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Xor(const R a, const R b) noexcept requires CT::BuiltinInteger<T> {
+            return _mm_xor_si128(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R ShiftLeft(const R a, const int n) noexcept requires CT::BuiltinInteger<T> {
+            if constexpr (Wide) return _mm_sll_epi64(a, _mm_cvtsi32_si128(n));
+            else                return _mm_sll_epi32(a, _mm_cvtsi32_si128(n));
+         }
+
+         // Arithmetic shifts of 64-bit integers need AVX-512           
+         LANGULUS(ALWAYS_INLINED)
+         static R ShiftRight(const R a, const int n) noexcept
+         requires (CT::BuiltinInteger<T> and not (CT::Signed<T> and Wide)) {
+            if constexpr (CT::Signed<T>) return _mm_sra_epi32(a, _mm_cvtsi32_si128(n));
+            else if constexpr (Wide)     return _mm_srl_epi64(a, _mm_cvtsi32_si128(n));
+            else return _mm_srl_epi32(a, _mm_cvtsi32_si128(n));
+         }
+
+         // 64-bit integer comparisons need SSE4.1/4.2                  
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Eq(const R a, const R b) noexcept requires (not Wide or F64) {
+            if constexpr (F32)      return _mm_movemask_ps(_mm_cmpeq_ps(a, b));
+            else if constexpr (F64) return _mm_movemask_pd(_mm_cmpeq_pd(a, b));
+            else return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Lt(const R a, const R b) noexcept requires (not Wide or F64) {
+            if constexpr (F32)      return _mm_movemask_ps(_mm_cmplt_ps(a, b));
+            else if constexpr (F64) return _mm_movemask_pd(_mm_cmplt_pd(a, b));
+            else if constexpr (CT::Signed<T>)
+               return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(a, b)));
+            else {
+               // Flip the sign bits to compare unsigned as signed      
+               const auto sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+               return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(
+                  _mm_xor_si128(a, sign), _mm_xor_si128(b, sign))));
+            }
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Le(const R a, const R b) noexcept requires (not Wide or F64) {
+            if constexpr (F32)      return _mm_movemask_ps(_mm_cmple_ps(a, b));
+            else if constexpr (F64) return _mm_movemask_pd(_mm_cmple_pd(a, b));
+            else return ~Lt(b, a) & 0xF;
+         }
+
+         /// Reductions add the upper half to the lower half, until a         
+         /// single lane is left - the same order as the scalar fallback      
+         LANGULUS(ALWAYS_INLINED)
+         static T HSum(const R a) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) {
+               const auto s = _mm_add_ps(a, _mm_movehl_ps(a, a));
+               return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+            }
+            else return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a)));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static T HMin(const R a) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) {
+               const auto s = _mm_min_ps(a, _mm_movehl_ps(a, a));
+               return _mm_cvtss_f32(_mm_min_ss(s, _mm_shuffle_ps(s, s, 1)));
+            }
+            else return _mm_cvtsd_f64(_mm_min_sd(a, _mm_unpackhi_pd(a, a)));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static T HMax(const R a) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) {
+               const auto s = _mm_max_ps(a, _mm_movehl_ps(a, a));
+               return _mm_cvtss_f32(_mm_max_ss(s, _mm_shuffle_ps(s, s, 1)));
+            }
+            else return _mm_cvtsd_f64(_mm_max_sd(a, _mm_unpackhi_pd(a, a)));
+         }
+
+      #if LANGULUS_SIMD(AVX2)
+         template<CT::BuiltinSignedInteger I> LANGULUS(ALWAYS_INLINED)
+         static R Gather(const T* base, const I* indices) noexcept requires (sizeof(I) == sizeof(T)) {
+            const auto i = _mm_load_si128(reinterpret_cast<const __m128i*>(indices));
+            if constexpr (F32)       return _mm_i32gather_ps(base, i, 4);
+            else if constexpr (F64)  return _mm_i64gather_pd(base, i, 8);
+            else if constexpr (Wide) return _mm_i64gather_epi64(reinterpret_cast<const long long*>(base), i, 8);
+            else return _mm_i32gather_epi32(reinterpret_cast<const int*>(base), i, 4);
+         }
+      #endif
+      };
+   #endif
+
+   #if LANGULUS_SIMD(AVX)
+      ///                                                                     
+      /// 256-bit registers on x86 - integers need AVX2                       
+      ///                                                                     
+      template<SimdLane T> requires (CT::BuiltinReal<T> or LANGULUS_SIMD(AVX2) == 1)
+      struct SimdBackend<T, 32> {
+         using R = decltype(SimdRegister32<T>());
+         using Half = SimdBackend<T, 16>;
+         static constexpr bool F32 = CT::Exact<T, float>;
+         static constexpr bool F64 = CT::Exact<T, double>;
+         static constexpr bool Wide = sizeof(T) == 8;
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Load(const T* p) noexcept {
+            if constexpr (F32)      return _mm256_loadu_ps(p);
+            else if constexpr (F64) return _mm256_loadu_pd(p);
+            else return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R LoadAligned(const T* p) noexcept {
+            if constexpr (F32)      return _mm256_load_ps(p);
+            else if constexpr (F64) return _mm256_load_pd(p);
+            else return _mm256_load_si256(reinterpret_cast<const __m256i*>(p));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static void Store(T* p, const R r) noexcept {
+            if constexpr (F32)      _mm256_storeu_ps(p, r);
+            else if constexpr (F64) _mm256_storeu_pd(p, r);
+            else _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), r);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static void StoreAligned(T* p, const R r) noexcept {
+            if constexpr (F32)      _mm256_store_ps(p, r);
+            else if constexpr (F64) _mm256_store_pd(p, r);
+            else _mm256_store_si256(reinterpret_cast<__m256i*>(p), r);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Add(const R a, const R b) noexcept {
+            if constexpr (F32)       return _mm256_add_ps(a, b);
+            else if constexpr (F64)  return _mm256_add_pd(a, b);
+            else if constexpr (Wide) return _mm256_add_epi64(a, b);
+            else return _mm256_add_epi32(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Sub(const R a, const R b) noexcept {
+            if constexpr (F32)       return _mm256_sub_ps(a, b);
+            else if constexpr (F64)  return _mm256_sub_pd(a, b);
+            else if constexpr (Wide) return _mm256_sub_epi64(a, b);
+            else return _mm256_sub_epi32(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Mul(const R a, const R b) noexcept requires (not Wide or F64) {
+            if constexpr (F32)      return _mm256_mul_ps(a, b);
+            else if constexpr (F64) return _mm256_mul_pd(a, b);
+            else return _mm256_mullo_epi32(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Div(const R a, const R b) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm256_div_ps(a, b);
+            else               return _mm256_div_pd(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Min(const R a, const R b) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm256_min_ps(a, b);
+            else               return _mm256_min_pd(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Max(const R a, const R b) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm256_max_ps(a, b);
+            else               return _mm256_max_pd(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Sqrt(const R a) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm256_sqrt_ps(a);
+            else               return _mm256_sqrt_pd(a);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R And(const R a, const R b) noexcept requires CT::BuiltinInteger<T> {
+            return _mm256_and_si256(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Or(const R a, const R b) noexcept requires CT::BuiltinInteger<T> {
+            return _mm256_or_si256(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Xor(const R a, const R b) noexcept requires CT::BuiltinInteger<T> {
+            return _mm256_xor_si256(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R ShiftLeft(const R a, const int n) noexcept requires CT::BuiltinInteger<T> {
+            if constexpr (Wide) return _mm256_sll_epi64(a, _mm_cvtsi32_si128(n));
+            else                return _mm256_sll_epi32(a, _mm_cvtsi32_si128(n));
+         }
+
+         // Arithmetic shifts of 64-bit integers need AVX-512           
+         LANGULUS(ALWAYS_INLINED)
+         static R ShiftRight(const R a, const int n) noexcept
+         requires (CT::BuiltinInteger<T> and not (CT::Signed<T> and Wide)) {
+            if constexpr (CT::Signed<T>) return _mm256_sra_epi32(a, _mm_cvtsi32_si128(n));
+            else if constexpr (Wide)     return _mm256_srl_epi64(a, _mm_cvtsi32_si128(n));
+            else return _mm256_srl_epi32(a, _mm_cvtsi32_si128(n));
+         }
+
+         /// Get a mask from a register, where lanes are all ones or zeroes   
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t MaskOf(const __m256i m) noexcept {
+            if constexpr (Wide) return _mm256_movemask_pd(_mm256_castsi256_pd(m));
+            else                return _mm256_movemask_ps(_mm256_castsi256_ps(m));
+         }
+
+         /// Flip the sign bits to compare unsigned as signed                 
+         LANGULUS(ALWAYS_INLINED)
+         static __m256i Biased(const __m256i a) noexcept {
+            if constexpr (CT::Signed<T>)
+               return a;
+            else if constexpr (Wide)
+               return _mm256_xor_si256(a, _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull)));
+            else
+               return _mm256_xor_si256(a, _mm256_set1_epi32(static_cast<int>(0x80000000u)));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Eq(const R a, const R b) noexcept {
+            if constexpr (F32)       return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+            else if constexpr (F64)  return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+            else if constexpr (Wide) return MaskOf(_mm256_cmpeq_epi64(a, b));
+            else return MaskOf(_mm256_cmpeq_epi32(a, b));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Lt(const R a, const R b) noexcept {
+            if constexpr (F32)       return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ));
+            else if constexpr (F64)  return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ));
+            else if constexpr (Wide) return MaskOf(_mm256_cmpgt_epi64(Biased(b), Biased(a)));
+            else return MaskOf(_mm256_cmpgt_epi32(Biased(b), Biased(a)));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Le(const R a, const R b) noexcept {
+            if constexpr (F32)      return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ));
+            else if constexpr (F64) return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ));
+            else return ~Lt(b, a) & (Wide ? 0xF : 0xFF);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static T HSum(const R a) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32)
+               return Half::HSum(_mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1)));
+            else
+               return Half::HSum(_mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1)));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static T HMin(const R a) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32)
+               return Half::HMin(_mm_min_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1)));
+            else
+               return Half::HMin(_mm_min_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1)));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static T HMax(const R a) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32)
+               return Half::HMax(_mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1)));
+            else
+               return Half::HMax(_mm_max_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1)));
+         }
+
+      #if LANGULUS_SIMD(AVX2)
+         template<CT::BuiltinSignedInteger I> LANGULUS(ALWAYS_INLINED)
+         static R Gather(const T* base, const I* indices) noexcept requires (sizeof(I) == sizeof(T)) {
+            const auto i = _mm256_load_si256(reinterpret_cast<const __m256i*>(indices));
+            if constexpr (F32)       return _mm256_i32gather_ps(base, i, 4);
+            else if constexpr (F64)  return _mm256_i64gather_pd(base, i, 8);
+            else if constexpr (Wide) return _mm256_i64gather_epi64(reinterpret_cast<const long long*>(base), i, 8);
+            else return _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), i, 4);
+         }
+      #endif
+      };
+   #endif
+
+   #if LANGULUS_SIMD(AVX512)
+      ///                                                                     
+      /// 512-bit registers on x86, comparisons produce masks directly        
+      ///                                                                     
+      template<SimdLane T>
+      struct SimdBackend<T, 64> {
+         using R = decltype(SimdRegister64<T>());
+         using Half = SimdBackend<T, 32>;
+         static constexpr bool F32 = CT::Exact<T, float>;
+         static constexpr bool F64 = CT::Exact<T, double>;
+         static constexpr bool Wide = sizeof(T) == 8;
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Load(const T* p) noexcept {
+            if constexpr (F32)      return _mm512_loadu_ps(p);
+            else if constexpr (F64) return _mm512_loadu_pd(p);
+            else return _mm512_loadu_si512(p);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R LoadAligned(const T* p) noexcept {
+            if constexpr (F32)      return _mm512_load_ps(p);
+            else if constexpr (F64) return _mm512_load_pd(p);
+            else return _mm512_load_si512(p);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static void Store(T* p, const R r) noexcept {
+            if constexpr (F32)      _mm512_storeu_ps(p, r);
+            else if constexpr (F64) _mm512_storeu_pd(p, r);
+            else _mm512_storeu_si512(p, r);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static void StoreAligned(T* p, const R r) noexcept {
+            if constexpr (F32)      _mm512_store_ps(p, r);
+            else if constexpr (F64) _mm512_store_pd(p, r);
+            else _mm512_store_si512(p, r);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Add(const R a, const R b) noexcept {
+            if constexpr (F32)       return _mm512_add_ps(a, b);
+            else if constexpr (F64)  return _mm512_add_pd(a, b);
+            else if constexpr (Wide) return _mm512_add_epi64(a, b);
+            else return _mm512_add_epi32(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Sub(const R a, const R b) noexcept {
+            if constexpr (F32)       return _mm512_sub_ps(a, b);
+            else if constexpr (F64)  return _mm512_sub_pd(a, b);
+            else if constexpr (Wide) return _mm512_sub_epi64(a, b);
+            else return _mm512_sub_epi32(a, b);
+         }
+
+         // 64-bit integer multiplication needs AVX-512DQ               
+         LANGULUS(ALWAYS_INLINED)
+         static R Mul(const R a, const R b) noexcept requires (not Wide or F64) {
+            if constexpr (F32)      return _mm512_mul_ps(a, b);
+            else if constexpr (F64) return _mm512_mul_pd(a, b);
+            else return _mm512_mullo_epi32(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Div(const R a, const R b) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm512_div_ps(a, b);
+            else               return _mm512_div_pd(a, b);
+         }
+
+         // Zero-masked with a full mask, because the unmasked one trips
+         // -Wmaybe-uninitialized in GCC's own headers, and compiles to 
+         // the same instruction                                        
+         LANGULUS(ALWAYS_INLINED)
+         static R Min(const R a, const R b) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm512_maskz_min_ps(static_cast<__mmask16>(-1), a, b);
+            else               return _mm512_maskz_min_pd(static_cast<__mmask8>(-1), a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Max(const R a, const R b) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm512_maskz_max_ps(static_cast<__mmask16>(-1), a, b);
+            else               return _mm512_maskz_max_pd(static_cast<__mmask8>(-1), a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Sqrt(const R a) noexcept requires CT::BuiltinReal<T> {
+            if constexpr (F32) return _mm512_maskz_sqrt_ps(static_cast<__mmask16>(-1), a);
+            else               return _mm512_maskz_sqrt_pd(static_cast<__mmask8>(-1), a);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R And(const R a, const R b) noexcept requires CT::BuiltinInteger<T> {
+            return _mm512_and_si512(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Or(const R a, const R b) noexcept requires CT::BuiltinInteger<T> {
+            return _mm512_or_si512(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Xor(const R a, const R b) noexcept requires CT::BuiltinInteger<T> {
+            return _mm512_xor_si512(a, b);
+         }
+
+         // Zero-masked, like Min                                       
+         LANGULUS(ALWAYS_INLINED)
+         static R ShiftLeft(const R a, const int n) noexcept requires CT::BuiltinInteger<T> {
+            const auto count = _mm_cvtsi32_si128(n);
+            if constexpr (Wide) return _mm512_maskz_sll_epi64(static_cast<__mmask8>(-1), a, count);
+            else                return _mm512_maskz_sll_epi32(static_cast<__mmask16>(-1), a, count);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R ShiftRight(const R a, const int n) noexcept requires CT::BuiltinInteger<T> {
+            const auto count = _mm_cvtsi32_si128(n);
+            if constexpr (CT::Signed<T>) {
+               if constexpr (Wide) return _mm512_maskz_sra_epi64(static_cast<__mmask8>(-1), a, count);
+               else                return _mm512_maskz_sra_epi32(static_cast<__mmask16>(-1), a, count);
+            }
+            else {
+               if constexpr (Wide) return _mm512_maskz_srl_epi64(static_cast<__mmask8>(-1), a, count);
+               else                return _mm512_maskz_srl_epi32(static_cast<__mmask16>(-1), a, count);
+            }
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Eq(const R a, const R b) noexcept {
+            if constexpr (F32)       return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+            else if constexpr (F64)  return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+            else if constexpr (Wide) return _mm512_cmpeq_epi64_mask(a, b);
+            else return _mm512_cmpeq_epi32_mask(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Lt(const R a, const R b) noexcept {
+            if constexpr (F32)      return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+            else if constexpr (F64) return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+            else if constexpr (CT::Signed<T>) {
+               if constexpr (Wide) return _mm512_cmplt_epi64_mask(a, b);
+               else                return _mm512_cmplt_epi32_mask(a, b);
+            }
+            else {
+               if constexpr (Wide) return _mm512_cmplt_epu64_mask(a, b);
+               else                return _mm512_cmplt_epu32_mask(a, b);
+            }
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Le(const R a, const R b) noexcept {
+            if constexpr (F32)      return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ);
+            else if constexpr (F64) return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ);
+            else if constexpr (CT::Signed<T>) {
+               if constexpr (Wide) return _mm512_cmple_epi64_mask(a, b);
+               else                return _mm512_cmple_epi32_mask(a, b);
+            }
+            else {
+               if constexpr (Wide) return _mm512_cmple_epu64_mask(a, b);
+               else                return _mm512_cmple_epu32_mask(a, b);
+            }
+         }
+
+         /// Pick lanes from yes, where the mask is set, and from no elsewhere
+         LANGULUS(ALWAYS_INLINED)
+         static R Select(const ::std::uint64_t mask, const R yes, const R no) noexcept {
+            if constexpr (F32)       return _mm512_mask_blend_ps(static_cast<__mmask16>(mask), no, yes);
+            else if constexpr (F64)  return _mm512_mask_blend_pd(static_cast<__mmask8>(mask), no, yes);
+            else if constexpr (Wide) return _mm512_mask_blend_epi64(static_cast<__mmask8>(mask), no, yes);
+            else return _mm512_mask_blend_epi32(static_cast<__mmask16>(mask), no, yes);
+         }
+
+         /// Split into halves, without needing AVX-512DQ                     
+         /// Extracted zero-masked, like Min - GCC's casts to the low half    
+         /// are extractions over an undefined vector, too                    
+         template<int HALF> LANGULUS(ALWAYS_INLINED)
+         static auto Extract(const R a) noexcept {
+            constexpr auto all = static_cast<__mmask8>(-1);
+            if constexpr (F32) return _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(all, _mm512_castps_pd(a), HALF));
+            else               return _mm512_maskz_extractf64x4_pd(all, a, HALF);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static auto Low(const R a) noexcept {
+            return Extract<0>(a);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static auto High(const R a) noexcept {
+            return Extract<1>(a);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static T HSum(const R a) noexcept requires CT::BuiltinReal<T> {
+            return Half::HSum(Half::Add(Low(a), High(a)));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static T HMin(const R a) noexcept requires CT::BuiltinReal<T> {
+            return Half::HMin(Half::Min(Low(a), High(a)));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static T HMax(const R a) noexcept requires CT::BuiltinReal<T> {
+            return Half::HMax(Half::Max(Low(a), High(a)));
+         }
+
+         /// Masked with a full mask, and gathered over zeroes, like Min      
+         template<CT::BuiltinSignedInteger I> LANGULUS(ALWAYS_INLINED)
+         static R Gather(const T* base, const I* indices) noexcept requires (sizeof(I) == sizeof(T)) {
+            const auto i = _mm512_load_si512(indices);
+            constexpr auto all8 = static_cast<__mmask8>(-1);
+            constexpr auto all16 = static_cast<__mmask16>(-1);
+            if constexpr (F32)       return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), all16, i, base, 4);
+            else if constexpr (F64)  return _mm512_mask_i64gather_pd(_mm512_setzero_pd(), all8, i, base, 8);
+            else if constexpr (Wide) return _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), all8, i, base, 8);
+            else return _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), all16, i, base, 4);
+         }
+      };
+   #endif
+
+   #if LANGULUS_SIMD(NEON) and LANGULUS_BITNESS() == 64
+      ///                                                                     
+      /// 128-bit registers on 64-bit ARM, only for floats                    
+      ///                                                                     
+      template<>
+      struct SimdBackend<float, 16> {
+         using R = float32x4_t;
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Load(const float* p) noexcept {
+            return vld1q_f32(p);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R LoadAligned(const float* p) noexcept {
+            return vld1q_f32(p);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static void Store(float* p, const R r) noexcept {
+            vst1q_f32(p, r);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static void StoreAligned(float* p, const R r) noexcept {
+            vst1q_f32(p, r);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Add(const R a, const R b) noexcept {
+            return vaddq_f32(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Sub(const R a, const R b) noexcept {
+            return vsubq_f32(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Mul(const R a, const R b) noexcept {
+            return vmulq_f32(a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Div(const R a, const R b) noexcept {
+            return vdivq_f32(a, b);
+         }
+
+         /// vminq_f32 propagates NaNs, so select instead, to match x86       
+         LANGULUS(ALWAYS_INLINED)
+         static R Min(const R a, const R b) noexcept {
+            return vbslq_f32(vcltq_f32(a, b), a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Max(const R a, const R b) noexcept {
+            return vbslq_f32(vcgtq_f32(a, b), a, b);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static R Sqrt(const R a) noexcept {
+            return vsqrtq_f32(a);
+         }
+
+         /// Get a mask from a register, where lanes are all ones or zeroes   
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t MaskOf(const uint32x4_t m) noexcept {
+            static constexpr ::std::uint32_t weights[] {1, 2, 4, 8};
+            return vaddvq_u32(vandq_u32(m, vld1q_u32(weights)));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Eq(const R a, const R b) noexcept {
+            return MaskOf(vceqq_f32(a, b));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Lt(const R a, const R b) noexcept {
+            return MaskOf(vcltq_f32(a, b));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static ::std::uint64_t Le(const R a, const R b) noexcept {
+            return MaskOf(vcleq_f32(a, b));
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static float HSum(const R a) noexcept {
+            const auto s = vadd_f32(vget_low_f32(a), vget_high_f32(a));
+            return vget_lane_f32(s, 0) + vget_lane_f32(s, 1);
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static float HMin(const R a) noexcept {
+            const auto l = vget_low_f32(a);
+            const auto h = vget_high_f32(a);
+            const auto s = vbsl_f32(vclt_f32(l, h), l, h);
+            const auto x = vget_lane_f32(s, 0);
+            const auto y = vget_lane_f32(s, 1);
+            return x < y ? x : y;
+         }
+
+         LANGULUS(ALWAYS_INLINED)
+         static float HMax(const R a) noexcept {
+            const auto l = vget_low_f32(a);
+            const auto h = vget_high_f32(a);
+            const auto s = vbsl_f32(vcgt_f32(l, h), l, h);
+            const auto x = vget_lane_f32(s, 0);
+            const auto y = vget_lane_f32(s, 1);
+            return x > y ? x : y;
+         }
+      };
+   #endif
+
+   } // namespace Langulus::Inner
+
+
+   ///                                                                        
+   ///   Vector of numbers, that are processed together                       
+   ///                                                                        
+   /// Backed by SSE2, AVX/AVX2, AVX-512 or NEON registers, depending on      
+   /// what the code is built for (see LANGULUS_SIMD), and by plain loops     
+   /// for anything else - including constant evaluation, so it can be used   
+   /// at compile-time, too. Results are the same with any backend, and       
+   /// horizontal reductions always combine the upper half of the lanes       
+   /// with the lower half, so they don't depend on the backend either        
+   ///   @tparam T - the type of a lane                                       
+   ///   @tparam N - the number of lanes                                      
+   ///                                                                        
+   template<CT::BuiltinNumber T, Count N>
+   class alignas(Inner::SimdAlignment<T, N>) Simd {
+      static_assert(N > 0, "Vectors must have at least one lane");
+      template<CT::BuiltinNumber, Count>
+      friend class Simd;
+
+   public:
+      using Type = T;
+      static constexpr Count Lanes = N;
+      static constexpr Offset Bytes = sizeof(T) * N;
+      /// True if LANGULUS_ALIGNED() memory, and Core allocations with the    
+      /// default alignment, are always aligned enough for LoadAligned        
+      static constexpr bool AlignedByDefault = Inner::SimdAlignment<T, N> <= Alignment;
+
+   private:
+      using Backend = Inner::SimdBackend<T, Bytes>;
+      using Mask = SimdMask<N>;
+
+      T mLanes[N] {};
+
+      NOD() LANGULUS(ALWAYS_INLINED)
+      auto Get() const noexcept {
+         return Backend::LoadAligned(mLanes);
+      }
+
+      template<class R> NOD() LANGULUS(ALWAYS_INLINED)
+      static Simd From(const R r) noexcept {
+         Simd result;
+         Backend::StoreAligned(result.mLanes, r);
+         return result;
+      }
+
+      /// Apply an operation lane by lane                                     
+      template<class F> NOD() LANGULUS(ALWAYS_INLINED)
+      static constexpr Simd Zip(const Simd& lhs, const Simd& rhs, F&& f) noexcept {
+         Simd result;
+         for (Offset i = 0; i < N; ++i)
+            result.mLanes[i] = static_cast<T>(f(lhs.mLanes[i], rhs.mLanes[i]));
+         return result;
+      }
+
+      /// Compare lane by lane                                                
+      template<class F> NOD() LANGULUS(ALWAYS_INLINED)
+      static constexpr Mask Compare(const Simd& lhs, const Simd& rhs, F&& f) noexcept {
+         ::std::uint64_t bits = 0;
+         for (Offset i = 0; i < N; ++i)
+            bits |= static_cast<::std::uint64_t>(f(lhs.mLanes[i], rhs.mLanes[i])) << i;
+         return Mask {bits};
+      }
+
+      /// Reduce by combining the upper half of the lanes with the lower one  
+      template<class F> NOD() LANGULUS(ALWAYS_INLINED)
+      constexpr T Reduce(F&& f) const noexcept {
+         T t[N];
+         for (Offset i = 0; i < N; ++i)
+            t[i] = mLanes[i];
+         for (Count width = N; width > 1; width -= width / 2) {
+            const auto half = width / 2;
+            const auto offset = width - half;
+            for (Offset i = 0; i < half; ++i)
+               t[i] = static_cast<T>(f(t[i], t[i + offset]));
+         }
+         return t[0];
+      }
+
+   public:
+      /// Create a vector of zeroes                                           
+      constexpr Simd() noexcept = default;
+
+      /// Create a vector with all lanes the same                             
+      ///   @param value - the value of all lanes                             
+      LANGULUS(INLINED)
+      constexpr Simd(const T value) noexcept {
+         for (auto& lane : mLanes)
+            lane = value;
+      }
+
+      /// Create a vector from the values of all lanes                        
+      ///   @param values - the values, one for each lane                     
+      template<CT::BuiltinNumber... A> LANGULUS(INLINED)
+      constexpr Simd(const A... values) noexcept requires (N > 1 and sizeof...(A) == N)
+         : mLanes {static_cast<T>(values)...} {}
+
+      /// Load lanes from memory                                              
+      ///   @param source - the lanes, no alignment required                  
+      ///   @return the vector                                                
+      NOD() LANGULUS(INLINED)
+      static constexpr Simd Load(const T* source) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires { Backend::Load(source); })
+            return From(Backend::Load(source));
+
+         Simd result;
+         for (Offset i = 0; i < N; ++i)
+            result.mLanes[i] = source[i];
+         return result;
+      }
+
+      /// Load lanes from aligned memory                                      
+      ///   @param source - the lanes, aligned to the size of the vector -    
+      ///                   LANGULUS_ALIGNED() memory is, if AlignedByDefault 
+      ///   @return the vector                                                
+      ///   @attention in safe mode, throws Except::Access if misaligned      
+      NOD() LANGULUS(INLINED)
+      static constexpr Simd LoadAligned(const T* source) noexcept(not LANGULUS(SAFE)) {
+         IF_CONSTEXPR() {}
+         else {
+            #if LANGULUS(SAFE)
+               if (reinterpret_cast<Pointer>(source) % Inner::SimdAlignment<T, N>)
+                  Throw<Except::Access>("Misaligned vector load", LANGULUS_LOCATION());
+            #endif
+            if constexpr (requires { Backend::LoadAligned(source); })
+               return From(Backend::LoadAligned(source));
+         }
+
+         Simd result;
+         for (Offset i = 0; i < N; ++i)
+            result.mLanes[i] = source[i];
+         return result;
+      }
+
+      /// Load lanes from scattered places                                    
+      ///   @param base - the start of the array to gather from               
+      ///   @param indices - the index of each lane in the array              
+      ///   @return the vector                                                
+      template<CT::BuiltinInteger I> NOD() LANGULUS(INLINED)
+      static constexpr Simd Gather(const T* base, const Simd<I, N>& indices) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires { Backend::Gather(base, indices.mLanes); })
+            return From(Backend::Gather(base, indices.mLanes));
+
+         Simd result;
+         for (Offset i = 0; i < N; ++i)
+            result.mLanes[i] = base[indices.mLanes[i]];
+         return result;
+      }
+
+      /// Store lanes to memory                                               
+      ///   @param target - where to store, no alignment required             
+      LANGULUS(INLINED)
+      constexpr void Store(T* target) const noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Store(target, r); })
+            return Backend::Store(target, Get());
+
+         for (Offset i = 0; i < N; ++i)
+            target[i] = mLanes[i];
+      }
+
+      /// Store lanes to aligned memory                                       
+      ///   @param target - where to store, aligned like for LoadAligned      
+      ///   @attention in safe mode, throws Except::Access if misaligned      
+      LANGULUS(INLINED)
+      constexpr void StoreAligned(T* target) const noexcept(not LANGULUS(SAFE)) {
+         IF_CONSTEXPR() {}
+         else {
+            #if LANGULUS(SAFE)
+               if (reinterpret_cast<Pointer>(target) % Inner::SimdAlignment<T, N>)
+                  Throw<Except::Access>("Misaligned vector store", LANGULUS_LOCATION());
+            #endif
+            if constexpr (requires (typename Backend::R r) { Backend::StoreAligned(target, r); })
+               return Backend::StoreAligned(target, Get());
+         }
+
+         for (Offset i = 0; i < N; ++i)
+            target[i] = mLanes[i];
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr const T& operator [] (const Offset lane) const noexcept {
+         return mLanes[lane];
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr T& operator [] (const Offset lane) noexcept {
+         return mLanes[lane];
+      }
+
+      /// Get the same bits as lanes of another type, of the same size        
+      /// Use it to manipulate the bits of reals, for example                 
+      ///   @tparam U - the type of lanes to reinterpret as                   
+      ///   @return the reinterpreted vector                                  
+      template<CT::BuiltinNumber U> NOD() LANGULUS(INLINED)
+      constexpr Simd<U, N> Reinterpret() const noexcept requires (sizeof(U) == sizeof(T)) {
+         return ::std::bit_cast<Simd<U, N>>(*this);
+      }
+
+      ///                                                                     
+      ///   Arithmetics                                                       
+      ///                                                                     
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd operator + (const Simd& lhs, const Simd& rhs) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Add(r, r); })
+            return From(Backend::Add(lhs.Get(), rhs.Get()));
+         return Zip(lhs, rhs, [](T a, T b) { return a + b; });
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd operator - (const Simd& lhs, const Simd& rhs) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Sub(r, r); })
+            return From(Backend::Sub(lhs.Get(), rhs.Get()));
+         return Zip(lhs, rhs, [](T a, T b) { return a - b; });
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd operator * (const Simd& lhs, const Simd& rhs) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Mul(r, r); })
+            return From(Backend::Mul(lhs.Get(), rhs.Get()));
+         return Zip(lhs, rhs, [](T a, T b) { return a * b; });
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd operator / (const Simd& lhs, const Simd& rhs) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Div(r, r); })
+            return From(Backend::Div(lhs.Get(), rhs.Get()));
+         return Zip(lhs, rhs, [](T a, T b) { return a / b; });
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr Simd operator - () const noexcept requires CT::Signed<T> {
+         Simd result;
+         for (Offset i = 0; i < N; ++i)
+            result.mLanes[i] = static_cast<T>(-mLanes[i]);
+         return result;
+      }
+
+      LANGULUS(INLINED)
+      constexpr Simd& operator += (const Simd& rhs) noexcept {
+         return *this = *this + rhs;
+      }
+
+      LANGULUS(INLINED)
+      constexpr Simd& operator -= (const Simd& rhs) noexcept {
+         return *this = *this - rhs;
+      }
+
+      LANGULUS(INLINED)
+      constexpr Simd& operator *= (const Simd& rhs) noexcept {
+         return *this = *this * rhs;
+      }
+
+      LANGULUS(INLINED)
+      constexpr Simd& operator /= (const Simd& rhs) noexcept {
+         return *this = *this / rhs;
+      }
+
+      /// Get the smaller of each pair of lanes, which is rhs if unordered    
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd Min(const Simd& lhs, const Simd& rhs) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Min(r, r); })
+            return From(Backend::Min(lhs.Get(), rhs.Get()));
+         return Zip(lhs, rhs, [](T a, T b) { return a < b ? a : b; });
+      }
+
+      /// Get the bigger of each pair of lanes, which is rhs if unordered     
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd Max(const Simd& lhs, const Simd& rhs) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Max(r, r); })
+            return From(Backend::Max(lhs.Get(), rhs.Get()));
+         return Zip(lhs, rhs, [](T a, T b) { return a > b ? a : b; });
+      }
+
+      /// Get the square root of each lane                                    
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd Sqrt(const Simd& value) noexcept requires CT::BuiltinReal<T> {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Sqrt(r); })
+            return From(Backend::Sqrt(value.Get()));
+
+         Simd result;
+         for (Offset i = 0; i < N; ++i)
+            result.mLanes[i] = ::std::sqrt(value.mLanes[i]);
+         return result;
+      }
+
+      ///                                                                     
+      ///   Bitwise operations, only for integers                             
+      ///                                                                     
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd operator & (const Simd& lhs, const Simd& rhs) noexcept
+      requires CT::BuiltinInteger<T> {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::And(r, r); })
+            return From(Backend::And(lhs.Get(), rhs.Get()));
+         return Zip(lhs, rhs, [](T a, T b) { return a & b; });
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd operator | (const Simd& lhs, const Simd& rhs) noexcept
+      requires CT::BuiltinInteger<T> {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Or(r, r); })
+            return From(Backend::Or(lhs.Get(), rhs.Get()));
+         return Zip(lhs, rhs, [](T a, T b) { return a | b; });
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd operator ^ (const Simd& lhs, const Simd& rhs) noexcept
+      requires CT::BuiltinInteger<T> {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Xor(r, r); })
+            return From(Backend::Xor(lhs.Get(), rhs.Get()));
+         return Zip(lhs, rhs, [](T a, T b) { return a ^ b; });
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr Simd operator ~ () const noexcept requires CT::BuiltinInteger<T> {
+         return *this ^ Simd {static_cast<T>(~T {0})};
+      }
+
+      /// Shift all lanes by the same number of bits                          
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd operator << (const Simd& lhs, const int bits) noexcept
+      requires CT::BuiltinInteger<T> {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::ShiftLeft(r, 0); })
+            return From(Backend::ShiftLeft(lhs.Get(), bits));
+
+         Simd result;
+         for (Offset i = 0; i < N; ++i)
+            result.mLanes[i] = static_cast<T>(lhs.mLanes[i] << bits);
+         return result;
+      }
+
+      /// Shift all lanes by the same number of bits, arithmetic if signed    
+      NOD() LANGULUS(INLINED)
+      friend constexpr Simd operator >> (const Simd& lhs, const int bits) noexcept
+      requires CT::BuiltinInteger<T> {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::ShiftRight(r, 0); })
+            return From(Backend::ShiftRight(lhs.Get(), bits));
+
+         Simd result;
+         for (Offset i = 0; i < N; ++i)
+            result.mLanes[i] = static_cast<T>(lhs.mLanes[i] >> bits);
+         return result;
+      }
+
+      ///                                                                     
+      ///   Comparisons, that produce a mask                                  
+      ///                                                                     
+      NOD() LANGULUS(INLINED)
+      friend constexpr Mask operator == (const Simd& lhs, const Simd& rhs) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Eq(r, r); })
+            return Mask {Backend::Eq(lhs.Get(), rhs.Get())};
+         return Compare(lhs, rhs, [](T a, T b) { return a == b; });
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr Mask operator != (const Simd& lhs, const Simd& rhs) noexcept {
+         return ~(lhs == rhs);
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr Mask operator < (const Simd& lhs, const Simd& rhs) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Lt(r, r); })
+            return Mask {Backend::Lt(lhs.Get(), rhs.Get())};
+         return Compare(lhs, rhs, [](T a, T b) { return a < b; });
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr Mask operator <= (const Simd& lhs, const Simd& rhs) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Le(r, r); })
+            return Mask {Backend::Le(lhs.Get(), rhs.Get())};
+         return Compare(lhs, rhs, [](T a, T b) { return a <= b; });
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr Mask operator > (const Simd& lhs, const Simd& rhs) noexcept {
+         return rhs < lhs;
+      }
+
+      NOD() LANGULUS(INLINED)
+      friend constexpr Mask operator >= (const Simd& lhs, const Simd& rhs) noexcept {
+         return rhs <= lhs;
+      }
+
+      /// Pick lanes from two vectors                                         
+      ///   @param mask - where to pick from yes, usually from a comparison   
+      ///   @param yes - the lanes to pick where the mask is set              
+      ///   @param no - the lanes to pick elsewhere                           
+      ///   @return the picked lanes                                          
+      NOD() LANGULUS(INLINED)
+      static constexpr Simd Select(const Mask& mask, const Simd& yes, const Simd& no) noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::Select(0, r, r); })
+            return From(Backend::Select(mask.GetBits(), yes.Get(), no.Get()));
+
+         Simd result;
+         for (Offset i = 0; i < N; ++i)
+            result.mLanes[i] = mask[i] ? yes.mLanes[i] : no.mLanes[i];
+         return result;
+      }
+
+      ///                                                                     
+      ///   Horizontal reductions                                             
+      ///                                                                     
+      /// Sum all lanes                                                       
+      NOD() LANGULUS(INLINED)
+      constexpr T HSum() const noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::HSum(r); })
+            return Backend::HSum(Get());
+         return Reduce([](T a, T b) { return a + b; });
+      }
+
+      /// Get the smallest lane                                               
+      NOD() LANGULUS(INLINED)
+      constexpr T HMin() const noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::HMin(r); })
+            return Backend::HMin(Get());
+         return Reduce([](T a, T b) { return a < b ? a : b; });
+      }
+
+      /// Get the biggest lane                                                
+      NOD() LANGULUS(INLINED)
+      constexpr T HMax() const noexcept {
+         IF_CONSTEXPR() {}
+         else if constexpr (requires (typename Backend::R r) { Backend::HMax(r); })
+            return Backend::HMax(Get());
+         return Reduce([](T a, T b) { return a > b ? a : b; });
+      }
+   };
+
+} // namespace Langulus
@@ -0,0 +1,92 @@
+///                                                                           
+/// Langulus::Core                                                            
+/// Copyright (c) 2012 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Hash.hpp"
+
+
+namespace Langulus
+{
+
+   namespace Inner
+   {
+
+      /// The decorated name of this function contains the name of T          
+      template<class T>
+      consteval Token DecoratedTypeName() noexcept {
+         return LANGULUS_FUNCTION();
+      }
+
+      /// The decoration around the type name is the same for every T, so we  
+      /// measure it once, by looking for a known type                        
+      constexpr Token TypeNameProbe = DecoratedTypeName<double>();
+      constexpr Offset TypeNamePrefix = TypeNameProbe.find("double");
+      constexpr Offset TypeNameSuffix = TypeNameProbe.size() - TypeNamePrefix - 6;
+
+      static_assert(TypeNamePrefix != Token::npos,
+         "LANGULUS_FUNCTION() doesn't contain template arguments on this compiler");
+
+      /// Strip the decoration from the name of T                             
+      template<class T>
+      consteval Token TrimmedTypeName() noexcept {
+         auto name = DecoratedTypeName<T>();
+         name = name.substr(TypeNamePrefix, name.size() - TypeNamePrefix - TypeNameSuffix);
+
+         // MSVC puts the kind of class types in front of their names   
+         #if LANGULUS_COMPILER(MSVC)
+            for (Token kind : {"class ", "struct ", "union ", "enum "}) {
+               if (name.starts_with(kind)) {
+                  name.remove_prefix(kind.size());
+                  break;
+               }
+            }
+         #endif
+         return name;
+      }
+
+      /// The name of T, in a null-terminated array of its own, so that the   
+      /// decorated names don't end up in the binary                          
+      template<class T>
+      struct TypeNameOf {
+         static constexpr Token Trimmed = TrimmedTypeName<T>();
+         static constexpr auto Storage = []() {
+            ::std::array<Letter, Trimmed.size() + 1> result {};
+            for (Offset i = 0; i < Trimmed.size(); ++i)
+               result[i] = Trimmed[i];
+            return result;
+         }();
+         static constexpr Token Name {Storage.data(), Trimmed.size()};
+         static constexpr Hash Hashed = HashBytes(Name.data(), Name.size());
+      };
+
+   } // namespace Langulus::Inner
+
+
+   /// Get the name of a type, as written by the compiler, at compile-time    
+   /// The name is stable across shared libraries, as long as they're built   
+   /// with the same compiler, so it can be used to identify types without    
+   /// relying on RTTI, or on addresses of static variables                   
+   ///   @attention names differ between compilers, and types in anonymous    
+   ///              namespaces are not unique between translation units       
+   ///   @tparam T - the type to get the name of                              
+   ///   @return the name, that is also null-terminated                       
+   template<class T> NOD()
+   consteval Token TypeName() noexcept {
+      return Inner::TypeNameOf<T>::Name;
+   }
+
+   /// Get the hash of a type's name at compile-time                          
+   /// Use it as a key for type registries and comparisons - it is built into 
+   /// the binary, so nothing is computed on program launch                   
+   ///   @tparam T - the type to get the hash of                              
+   ///   @return the hash of TypeName<T>()                                    
+   template<class T> NOD()
+   consteval Hash TypeHash() noexcept {
+      return Inner::TypeNameOf<T>::Hashed;
+   }
+
+} // namespace Langulus
@@ -6,12 +6,64 @@
 /// SPDX-License-Identifier: MIT                                              
 ///                                                                           
 #pragma once
-#include "Common.hpp"
+#include "Sequences.hpp"
 
 
 namespace Langulus
 {
 
+   namespace Inner
+   {
+
+      /// A type, tagged with its index inside a type list                    
+      template<Offset IDX, class T>
+      struct IndexedType {
+         using Type = T;
+      };
+
+      /// Inherits all types of a list, tagged with their indices, so that    
+      /// overload resolution can pick a type by index, without recursion     
+      template<class, class...>
+      struct TypeIndexer;
+
+      template<Offset...IDX, class...T>
+      struct TypeIndexer<ExpandedSequence<IDX...>, T...> : IndexedType<IDX, T>... {};
+
+      template<Offset IDX, class T>
+      IndexedType<IDX, T> SelectType(const IndexedType<IDX, T>&) {
+         static_assert(false, "Calling SelectType is ill-formed");
+      }
+
+      /// Get a type from a list by index                                     
+      template<Offset IDX, class...T>
+      using TypeAt = typename decltype(SelectType<IDX>(
+         Fake<TypeIndexer<::std::make_integer_sequence<Offset, sizeof...(T)>, T...>>()
+      ))::Type;
+
+      /// Get the index of the first type in a list, that exactly matches X   
+      ///   @return the index, or the number of types if X is not in the list 
+      template<class X, class...T>
+      consteval Offset TypeIndexOf() noexcept {
+         constexpr bool matches[] {CT::Exact<X, T>...};
+         for (Offset i = 0; i < sizeof...(T); ++i) {
+            if (matches[i])
+               return i;
+         }
+         return sizeof...(T);
+      }
+
+      /// Call the generator instantiation for the type at a runtime index    
+      template<class...T, class LAMBDA> LANGULUS(INLINED)
+      constexpr decltype(auto) TypeVisit(const Offset index, LAMBDA& generator) {
+         return Sequence<sizeof...(T)>::Dispatch(index,
+            [&]<Offset IDX>() -> decltype(auto) {
+               return generator.template operator()<TypeAt<IDX, T...>>();
+            }
+         );
+      }
+
+   } // namespace Langulus::Inner
+
    ///                                                                        
    ///   Compile-time type list                                               
    ///                                                                        
@@ -48,6 +100,20 @@ namespace Langulus
 
       template<class LIST>
       using Concat = decltype(ConcatInner(LIST {}));
+
+      template<class X>
+      static constexpr Offset IndexOf = CT::Exact<X, T> ? 0 : 1;
+
+      template<class X>
+      static constexpr bool Contains = CT::Exact<X, T>;
+
+      template<Offset IDX> requires (IDX == 0)
+      using At = T;
+
+      template<class LAMBDA>
+      static constexpr decltype(auto) Visit(const Offset index, LAMBDA&& generator) {
+         return Inner::TypeVisit<T>(index, generator);
+      }
    };
 
 
@@ -85,6 +151,33 @@ namespace Langulus
 
       template<class LIST>
       using Concat = decltype(ConcatInner(LIST {}));
+
+      /// Index of the first type that exactly matches X, or the number of    
+      /// types in the list, if there's no such type                          
+      template<class X>
+      static constexpr Offset IndexOf = Inner::TypeIndexOf<X, T1, T2, TN...>();
+
+      /// Check if the list contains a type that exactly matches X            
+      template<class X>
+      static constexpr bool Contains = CT::Exact<X, T1> or CT::Exact<X, T2>
+         or (CT::Exact<X, TN> or ...);
+
+      /// Get the type at an index                                            
+      template<Offset IDX>
+      using At = Inner::TypeAt<IDX, T1, T2, TN...>;
+
+      /// Call the generator with the type at an index, that is known only at 
+      /// runtime, via a single indirect call, instead of a linear scan       
+      ///   @param index - the index of the type, must be in range            
+      ///   @param generator - a templated lambda function, all               
+      ///                      instantiations must return the same type       
+      ///   @return whatever the generator returns                            
+      ///   @attention throws Except::OutOfRange in safe mode, if index is    
+      ///              out of range - the behavior is undefined otherwise     
+      template<class LAMBDA>
+      static constexpr decltype(auto) Visit(const Offset index, LAMBDA&& generator) {
+         return Inner::TypeVisit<T1, T2, TN...>(index, generator);
+      }
    };
 
 
@@ -114,6 +207,12 @@ namespace Langulus
 
       template<class LIST>
       using Concat = decltype(ConcatInner(LIST {}));
+
+      template<class X>
+      static constexpr Offset IndexOf = 0;
+
+      template<class X>
+      static constexpr bool Contains = false;
    };
 
 
@@ -6,7 +6,8 @@
 /// SPDX-License-Identifier: MIT                                              
 ///                                                                           
 #pragma once
-#include "Common.hpp"
+#include "Result.hpp"
+#include <new>
 
 
 namespace Langulus
@@ -50,36 +51,6 @@ namespace Langulus
       return static_cast<T&&>(a);
    }
    
-   /// Get number of digits inside an integer                                 
-   /// The routine is as statically optimized as possible                     
-   ///   @param n - value                                                     
-   ///   @return the number of digits inside the value                        
-   template<class T, T OFFSET = 10, Count RESULT = 1> NOD() LANGULUS(INLINED)
-   constexpr Count DigitsOf(const T n) noexcept {
-      if constexpr (::std::numeric_limits<T>::digits10 + 1 > RESULT) {
-         if constexpr (CT::Signed<T>) {
-            // Get rid of negatives                                     
-            using UnsignedT = ::std::make_unsigned_t<T>;
-            return DigitsOf<UnsignedT, OFFSET, RESULT>(
-               static_cast<UnsignedT>(::std::abs(n))
-            );
-         }
-         else {
-            if (n < OFFSET) {
-               // Early exit                                            
-               return RESULT;
-            }
-
-            // Next digit                                               
-            return DigitsOf<T, OFFSET * 10, RESULT + 1>(n);
-         }
-      }
-      else {
-         // Reached the numeric limit                                   
-         return RESULT;
-      }
-   }
-
    /// Check if an unsigned integer is a power of two                         
    ///   @param n - the number to test                                        
    ///   @return true if number has exactly one bit set                       
@@ -106,6 +77,70 @@ namespace Langulus
       return ::std::countl_zero(x);
    }
 
+   /// Full 64x64 -> 128 bit unsigned multiplication                          
+   ///   @param a - the left factor                                           
+   ///   @param b - the right factor                                          
+   ///   @param high - [out] the upper 64 bits of the product                 
+   ///   @return the lower 64 bits of the product                             
+   NOD() LANGULUS(ALWAYS_INLINED)
+   constexpr ::std::uint64_t MultiplyWide(
+      const ::std::uint64_t a, const ::std::uint64_t b, ::std::uint64_t& high
+   ) noexcept {
+   #if defined(__SIZEOF_INT128__)
+      __extension__ using U128 = unsigned __int128;
+      const auto r = static_cast<U128>(a) * b;
+      high = static_cast<::std::uint64_t>(r >> 64);
+      return static_cast<::std::uint64_t>(r);
+   #else
+      // Schoolbook multiplication over 32-bit halves                   
+      const ::std::uint64_t aLo = a & 0xFFFFFFFF, aHi = a >> 32;
+      const ::std::uint64_t bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+      const ::std::uint64_t ll = aLo * bLo;
+      const ::std::uint64_t lh = aLo * bHi;
+      const ::std::uint64_t hl = aHi * bLo;
+      const ::std::uint64_t hh = aHi * bHi;
+      const ::std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+      high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+      return (mid << 32) | (ll & 0xFFFFFFFF);
+   #endif
+   }
+
+   namespace Inner
+   {
+      /// Powers of ten, that fit in 64 bits                                  
+      constexpr ::std::uint64_t PowersOfTen[20] {
+         1ull, 10ull, 100ull, 1'000ull, 10'000ull, 100'000ull, 1'000'000ull,
+         10'000'000ull, 100'000'000ull, 1'000'000'000ull, 10'000'000'000ull,
+         100'000'000'000ull, 1'000'000'000'000ull, 10'000'000'000'000ull,
+         100'000'000'000'000ull, 1'000'000'000'000'000ull,
+         10'000'000'000'000'000ull, 100'000'000'000'000'000ull,
+         1'000'000'000'000'000'000ull, 10'000'000'000'000'000'000ull
+      };
+   }
+
+   /// Get number of digits inside an integer                                 
+   /// Branchless - log2 is obtained via CountLeadingZeroes, turned into an   
+   /// approximate log10 via multiplication by 1233/4096, and then corrected  
+   /// with a single table lookup                                             
+   ///   @param n - value                                                     
+   ///   @return the number of digits inside the value                        
+   template<CT::BuiltinInteger T> NOD() LANGULUS(INLINED)
+   constexpr Count DigitsOf(const T n) noexcept {
+      static_assert(sizeof(T) <= 8, "Integer too big");
+      ::std::uint64_t u;
+      if constexpr (CT::Signed<T>) {
+         // Get rid of negatives, without overflowing on the minimum    
+         using UnsignedT = ::std::make_unsigned_t<T>;
+         u = n < 0 ? static_cast<UnsignedT>(UnsignedT(0) - static_cast<UnsignedT>(n))
+                   : static_cast<UnsignedT>(n);
+      }
+      else u = n;
+
+      const auto bits = 64 - CountLeadingZeroes(u | 1);
+      const auto t = (static_cast<unsigned>(bits) * 1233) >> 12;
+      return t - ((u | 1) < Inner::PowersOfTen[t]) + 1;
+   }
+
    /// Round to the upper power-of-two                                        
    ///   @tparam SAFE - set to true if you want it to throw on overflow       
    ///   @tparam T - the unsigned integer type (deducible)                    
@@ -116,7 +151,7 @@ namespace Langulus
       if constexpr (SAFE) {
          constexpr T lastPowerOfTwo = (T {1}) << (T {sizeof(T) * 8 - 1});
          if (x > lastPowerOfTwo)
-            throw Except::Overflow("Roof2 overflowed");
+            Throw<Except::Overflow>("Roof2 overflowed", LANGULUS_LOCATION());
       }
 
       IF_CONSTEXPR() {
@@ -132,7 +167,7 @@ namespace Langulus
          if constexpr (sizeof(T) > 4)
             n |= n >> 32;
          if constexpr (sizeof(T) > 8)
-            throw Except::ToDo("Implement if struck");
+            Throw<Except::ToDo>("Implement if struck", LANGULUS_LOCATION());
 
          ++n;
          return n;
@@ -143,6 +178,18 @@ namespace Langulus
       }
    }
 
+   /// Round to the upper power-of-two, without throwing on overflow          
+   ///   @tparam T - the unsigned integer type (deducible)                    
+   ///   @param x - the unsigned integer to round up                          
+   ///   @return the closest upper power-of-two to x, or Except::Overflow     
+   template<CT::Unsigned T> NOD() LANGULUS(INLINED)
+   constexpr Result<T> Roof2(::std::nothrow_t, const T x) noexcept {
+      constexpr T lastPowerOfTwo = (T {1}) << (T {sizeof(T) * 8 - 1});
+      if (x > lastPowerOfTwo) UNLIKELY()
+         return Fail<Except::Overflow>("Roof2 overflowed", LANGULUS_LOCATION());
+      return Roof2(x);
+   }
+
    /// A somewhat safer reinterpret_cast for dense instances                  
    ///   @param what - reference to reinterpret                               
    ///   @return the result of reinterpret_cast<TO&>                          
@@ -209,7 +256,7 @@ namespace Langulus
          return DenseCast(a[0]);
       else if constexpr (CT::Sparse<T>) {
          if (a == nullptr)
-            throw Except::Access("Can't dereference nullptr");
+            Throw<Except::Access>("Can't dereference nullptr", LANGULUS_LOCATION());
 
          return DenseCast(*a);
       }
@@ -224,7 +271,7 @@ namespace Langulus
          return DenseCast(a[0]);
       else if constexpr (CT::Sparse<T>) {
          if (a == nullptr)
-            throw Except::Access("Can't dereference nullptr");
+            Throw<Except::Access>("Can't dereference nullptr", LANGULUS_LOCATION());
 
          return DenseCast(*a);
       }
@@ -239,13 +286,47 @@ namespace Langulus
          return DenseCastMutable(a[0]);
       else if constexpr (CT::Sparse<T>) {
          if (a == nullptr)
-            throw Except::Access("Can't dereference nullptr");
+            Throw<Except::Access>("Can't dereference nullptr", LANGULUS_LOCATION());
 
          return DenseCastMutable(*a);
       }
       else return const_cast<Decay<T>&>(a);
    }
 
+   /// Always returns a pointer to the dense value of the argument, without   
+   /// throwing on a null pointer                                             
+   /// If argument is an array, return a pointer to the first element         
+   ///   @return the pointer, never nullptr, or Except::Access                
+   template<class T> NOD()
+   constexpr auto DenseCast(::std::nothrow_t, T& a) noexcept
+   -> Result<Deref<decltype(DenseCast(a))>*> {
+      if constexpr (CT::Array<T>)
+         return DenseCast(::std::nothrow, a[0]);
+      else if constexpr (CT::Sparse<T>) {
+         if (a == nullptr) UNLIKELY()
+            return Fail<Except::Access>("Can't dereference nullptr", LANGULUS_LOCATION());
+         return DenseCast(::std::nothrow, *a);
+      }
+      else return &a;
+   }
+
+   /// Always returns a mutable pointer to the dense value of the argument,   
+   /// without throwing on a null pointer                                     
+   /// If argument is an array, return a pointer to the first element         
+   ///   @return the pointer, never nullptr, or Except::Access                
+   template<class T> NOD()
+   constexpr auto DenseCastMutable(::std::nothrow_t, const T& a) noexcept
+   -> Result<Decay<T>*> {
+      if constexpr (CT::Array<T>)
+         return DenseCastMutable(::std::nothrow, a[0]);
+      else if constexpr (CT::Sparse<T>) {
+         if (a == nullptr) UNLIKELY()
+            return Fail<Except::Access>("Can't dereference nullptr", LANGULUS_LOCATION());
+         return DenseCastMutable(::std::nothrow, *a);
+      }
+      else return const_cast<Decay<T>*>(&a);
+   }
+
    /// Align a value to an alignment                                          
    ///   @param v - the value to align                                        
    ///   @param alignment - the alignment to use                              